@@ -40,6 +40,16 @@ public class Seahorse.AppSettings : GLib.Settings {
         set { set_boolean("server-auto-retrieve", value); }
     }
 
+    public bool server_auto_refresh {
+        get { return get_boolean("server-auto-refresh"); }
+        set { set_boolean("server-auto-refresh", value); }
+    }
+
+    public uint server_refresh_period {
+        get { return get_uint("server-refresh-period"); }
+        set { set_uint("server-refresh-period", value); }
+    }
+
     public string server_publish_to {
         owned get { return get_string("server-publish-to"); }
         set { set_string("server-publish-to", value); }
@@ -29,6 +29,7 @@ public interface Backend : Gcr.Collection {
 
 	public void register() {
 		Registry.register_object(this, "backend");
+		KeyIndex.get_default().add_collection(this);
 	}
 
 	public static GLib.List<Backend> get_registered() {
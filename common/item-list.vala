@@ -33,9 +33,48 @@ public class Seahorse.ItemList : GLib.Object, GLib.ListModel {
     public Gcr.Collection base_collection { get; private set; }
     // XXX put back on private
 
-    /** The filtered and sorted list store */
+    /**
+     * The filtered and sorted list store. Since it's sorted on the cached
+     * sort keys, an item is found with a binary search.
+     */
     private GLib.GenericArray<GLib.Object> items = new GLib.GenericArray<GLib.Object>();
 
+    /**
+     * Items that were added to or removed from the collection, but not yet
+     * to or from the list. Only those with the matching flag in their
+     * ItemInfo still count.
+     */
+    private GLib.GenericArray<GLib.Object> pending_added = new GLib.GenericArray<GLib.Object>();
+    private GLib.GenericArray<GLib.Object> pending_removed = new GLib.GenericArray<GLib.Object>();
+    /** Hidden items that changed, and might match the filters now */
+    private GLib.GenericArray<GLib.Object> pending_changed = new GLib.GenericArray<GLib.Object>();
+    private uint pending_flush_id = 0;
+
+    /** Up to how many removed items are looked up, rather than walking the list */
+    private const int REMOVE_ONE_BY_ONE_MAX = 32;
+
+    /**
+     * What is sorted and searched on for every item, so it's only calculated
+     * once (and again when the item changes), and where to find it
+     */
+    [Compact]
+    private class ItemInfo {
+        /** The collation key of the label */
+        public string? sort_key;
+        /** All the text the item can be found with, casefolded (or null if unknown) */
+        public string? search_text;
+        public bool shown;
+        public bool pending_add;
+        public bool pending_remove;
+        public bool pending_change;
+        /** The refilter job this item was last sent to, until it changes */
+        public uint filter_serial;
+        /** Whether it matched in that job */
+        public bool filter_match;
+    }
+    private GLib.HashTable<GLib.Object, ItemInfo> item_infos
+        = new GLib.HashTable<GLib.Object, ItemInfo>(GLib.direct_hash, GLib.direct_equal);
+
     public enum ShowFilter {
         ANY,
         PERSONAL,
@@ -73,16 +112,106 @@ public class Seahorse.ItemList : GLib.Object, GLib.ListModel {
 
     public ShowFilter showfilter { get; set; default = ShowFilter.ANY; }
 
+    /** How long to wait for more typing before filtering */
+    private const uint FILTER_DELAY_MS = 150;
+
     private string _filter_text = "";
+    private uint filter_timeout_id = 0;
+
+    /**
+     * The search text. The list is only filtered once it didn't change for a
+     * little while, or when calling refilter().
+     */
     public string filter_text {
         set {
-            if (this._filter_text == value)
+            var text = value.casefold();
+            if (this._filter_text == text)
                 return;
-            this._filter_text = value.casefold();
-            refilter();
+            this._filter_text = text;
+
+            if (this.filter_timeout_id != 0) {
+                GLib.Source.remove(this.filter_timeout_id);
+                this.filter_timeout_id = 0;
+            }
+
+            // Clearing the search shouldn't have to wait
+            if (text == "")
+                refilter();
+            else
+                this.filter_timeout_id = GLib.Timeout.add(FILTER_DELAY_MS, on_filter_timeout);
         }
     }
 
+    /** The filters that were used to pick the current items */
+    private string applied_filter_text = "";
+    private ShowFilter applied_showfilter = ShowFilter.ANY;
+    /** The filter text as a query, if it is one (see {@link Query}) */
+    private Query? applied_query = null;
+
+    /** What queries look at; only kept up to date once a query was used */
+    private QueryIndex? query_index = null;
+
+    /** From how many items on the search text is matched in other threads */
+    private const int PARALLEL_FILTER_MIN = 10000;
+    /** How many items a thread matches at once */
+    private const int FILTER_CHUNK_SIZE = 2048;
+
+    /**
+     * A refilter that runs in the thread pool. The threads only get to see
+     * copies of the search texts, so they don't care what happens to the
+     * items meanwhile; the results are only used by the main thread, and
+     * only if no other refilter was started since.
+     */
+    private class FilterJob {
+        // Only touched on the main thread; unset once it's superseded
+        public unowned ItemList? list;
+        public uint serial;
+        public bool narrow;
+        public string filter_text;
+
+        // The items aren't referenced, since the threads don't need them
+        // and shouldn't be the ones to drop them
+        public GLib.GenericArray<unowned GLib.Object> objects;
+        // null for items that are left out by the showfilter
+        public string?[] search_texts;
+        public bool[] matches;
+
+        public int n_chunks_left;
+        public int cancelled;
+
+        public void cancel() {
+            GLib.AtomicInt.set(ref this.cancelled, 1);
+            this.list = null;
+        }
+
+        public bool is_cancelled() {
+            return GLib.AtomicInt.get(ref this.cancelled) != 0;
+        }
+    }
+
+    private class FilterChunk {
+        public FilterJob job;
+        public int start;
+        public int end;
+    }
+
+    private static GLib.ThreadPool<FilterChunk>? filter_pool = null;
+
+    private FilterJob? filter_job = null;
+    private uint last_filter_serial = 0;
+
+    /** Whether a refilter is still running in the background */
+    public bool refiltering {
+        get { return this.filter_job != null; }
+    }
+
+    private void set_filter_job(FilterJob? job) {
+        bool was_refiltering = this.refiltering;
+        set_filter_job(job);
+        if (this.refiltering != was_refiltering)
+            notify_property("refiltering");
+    }
+
     public ItemList(Gcr.Collection collection) {
         this.base_collection = collection;
 
@@ -91,50 +220,231 @@ public class Seahorse.ItemList : GLib.Object, GLib.ListModel {
         collection.removed.connect(on_collection_item_removed);
 
         // Add the existing elements
+        var objects = new GLib.GenericArray<GLib.Object>();
         foreach (weak GLib.Object obj in collection.get_objects())
-            this.items.add(obj);
+            objects.add(obj);
+        insert_items(objects);
+    }
 
-        // Sort afterwards
-        this.items.sort(compare_items);
+    ~ItemList() {
+        if (this.filter_job != null)
+            this.filter_job.cancel();
 
-        // Notify listeners
-        items_changed(0, 0, this.items.length);
+        foreach (unowned GLib.Object object in this.item_infos.get_keys())
+            object.notify.disconnect(on_item_notify);
     }
 
     private void on_collection_item_added(GLib.Object object) {
+        unowned ItemInfo? info = this.item_infos.lookup(object);
+
+        // It might not be gone yet after all
+        if (info != null && info.pending_remove) {
+            info.pending_remove = false;
+            return;
+        }
+
+        if (this.query_index != null) {
+            get_item_info(object);
+            this.query_index.invalidate(object);
+        }
+
         // First check if the current filter wants this
         if (!item_matches_filters(object))
             return;
 
-        int index = this.items.length;
-        for (int i = 0; i < this.items.length; i++) {
-            if (compare_items(object, this.items[i]) < 0) {
-                index = i;
-                break;
+        add_item_later(object, get_item_info(object));
+    }
+
+    // Collections tend to add a lot of items in one go (eg. when a keyring
+    // is loaded), so these are added together
+    private void add_item_later(GLib.Object object, ItemInfo info) {
+        if (info.shown || info.pending_add)
+            return;
+        info.pending_add = true;
+        this.pending_added.add(object);
+        schedule_flush();
+    }
+
+    private void on_collection_item_removed(GLib.Object object) {
+        unowned ItemInfo? info = this.item_infos.lookup(object);
+        if (info == null)
+            return;
+
+        // The same goes for removing them (eg. deleting a lot of keys)
+        if (info.shown) {
+            info.pending_remove = true;
+            this.pending_removed.add(object);
+            schedule_flush();
+            return;
+        }
+
+        forget_item(object);
+    }
+
+    private void schedule_flush() {
+        if (this.pending_flush_id == 0)
+            this.pending_flush_id = GLib.Idle.add(flush_pending);
+    }
+
+    private bool flush_pending() {
+        this.pending_flush_id = 0;
+
+        flush_removed();
+        flush_changed();
+
+        var added = new GLib.GenericArray<GLib.Object>();
+        foreach (unowned GLib.Object object in this.pending_added.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info != null && info.pending_add) {
+                info.pending_add = false;
+                added.add(object);
             }
         }
-        this.items.insert(index, object);
-        items_changed(index, 0, 1);
+        this.pending_added.remove_range(0, this.pending_added.length);
+
+        insert_items(added);
+
+        return GLib.Source.REMOVE;
     }
 
-    private void on_collection_item_removed(GLib.Object object) {
+    // Removes the items that are gone from the collection
+    private void flush_removed() {
+        var removed = new GLib.GenericArray<GLib.Object>();
+        foreach (unowned GLib.Object object in this.pending_removed.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info == null || !info.pending_remove)
+                continue;
+
+            if (info.shown)
+                removed.add(object);
+            else
+                forget_item(object);
+        }
+
+        // A few items are quickly found; otherwise, walk the list once
+        if (removed.length < REMOVE_ONE_BY_ONE_MAX) {
+            foreach (unowned GLib.Object object in removed.data) {
+                int index = find_item(object);
+                if (index >= 0) {
+                    this.items.remove_index(index);
+                    items_changed(index, 1, 0);
+                }
+            }
+        } else {
+            remove_items_where((object) => {
+                return this.item_infos.lookup(object).pending_remove;
+            });
+        }
+
+        // Only once they're out of the list, since that still needs them
+        foreach (unowned GLib.Object object in removed.data)
+            forget_item(object);
+
+        this.pending_removed.remove_range(0, this.pending_removed.length);
+    }
+
+    // Looks at the hidden items that changed again, once they're done
+    // changing; the ones that match now are added with the others
+    private void flush_changed() {
+        foreach (unowned GLib.Object object in this.pending_changed.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info == null || !info.pending_change)
+                continue;
+
+            info.pending_change = false;
+            if (!info.shown && !info.pending_add && item_matches_filters(object)) {
+                info.pending_add = true;
+                this.pending_added.add(object);
+            }
+        }
+        this.pending_changed.remove_range(0, this.pending_changed.length);
+    }
+
+    // Inserts the @objects in the list
+    private void insert_items(GLib.GenericArray<GLib.Object> objects) {
+        if (objects.length == 0)
+            return;
+
+        objects.sort_with_data(compare_items);
+        foreach (unowned GLib.Object object in objects.data)
+            get_item_info(object).shown = true;
+
+        // Filling an empty list is a lot simpler
+        if (this.items.length == 0) {
+            foreach (unowned GLib.Object object in objects.data)
+                this.items.add(object);
+            items_changed(0, 0, objects.length);
+            return;
+        }
+
+        merge_items(objects);
+    }
+
+    // Finds the position of @object in the list (or -1 if it's not shown)
+    private int find_item(GLib.Object object) {
+        int low = 0, high = this.items.length;
+
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (compare_items(this.items[mid], object) < 0)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        // Items with the same sort key can be in any order
+        for (int i = low; i < this.items.length && compare_items(this.items[i], object) == 0; i++) {
+            if (this.items[i] == object)
+                return i;
+        }
+
+        warn_if_reached();
         uint index;
-        if (this.items.find(object, out index)) {
-            this.items.remove_index(index);
-            items_changed(index, 1, 0);
+        return this.items.find(object, out index)? (int) index : -1;
+    }
+
+    // Finds the position after the last item that doesn't sort after @object
+    private int find_insert_position(GLib.Object object) {
+        int low = 0, high = this.items.length;
+
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (compare_items(object, this.items[mid]) < 0)
+                high = mid;
+            else
+                low = mid + 1;
         }
+
+        return low;
+    }
+
+    // Forgets everything about an item that left the collection
+    private void forget_item(GLib.Object object) {
+        if (this.query_index != null)
+            this.query_index.remove(object);
+        if (this.item_infos.remove(object))
+            object.notify.disconnect(on_item_notify);
     }
 
     private bool item_matches_filters(GLib.Object object) {
-        return matches_showfilter(object)
-            && object_contains_filtered_text(object, this._filter_text);
+        if (!matches_showfilter(object))
+            return false;
+
+        if (this.applied_query != null) {
+            // Makes sure it's forgotten by the index again
+            get_item_info(object);
+            return this.applied_query.matches(object, this.query_index,
+                                              object_contains_filtered_text);
+        }
+
+        return object_contains_filtered_text(object, this.applied_filter_text);
     }
 
     private bool matches_showfilter(GLib.Object? obj) {
         Flags obj_flags = Flags.NONE;
         obj.get("object-flags", out obj_flags, null);
 
-        switch (this.showfilter) {
+        switch (this.applied_showfilter) {
             case ShowFilter.PERSONAL:
                 return Seahorse.Flags.PERSONAL in obj_flags;
             case ShowFilter.TRUSTED:
@@ -147,37 +457,114 @@ public class Seahorse.ItemList : GLib.Object, GLib.ListModel {
     }
 
     // Search through row for text
-    private bool object_contains_filtered_text(GLib.Object? object, string? text) {
+    private bool object_contains_filtered_text(GLib.Object object, string text) {
         // Empty search text results in a match
-        if (text == null || text == "")
+        if (text == "")
             return true;
 
-        string? name = null;
-        object.get("label", out name, null);
-        if (name != null && (text in name.down()))
-            return true;
+        unowned ItemInfo info = get_item_info(object);
+        if (info.search_text == null)
+            info.search_text = calculate_search_text(object);
+
+        return text in info.search_text;
+    }
+
+    private unowned ItemInfo get_item_info(GLib.Object object) {
+        unowned ItemInfo? info = this.item_infos.lookup(object);
+
+        if (info == null) {
+            var new_info = new ItemInfo();
+            new_info.sort_key = calculate_sort_key(object);
+            info = new_info;
+            this.item_infos.insert(object, (owned) new_info);
+
+            object.notify.connect(on_item_notify);
+        }
+
+        return info;
+    }
+
+    // Items are sorted on their label in an intuitive way
+    // (case-insensitive; with respect to the user's locale)
+    private static string? calculate_sort_key(GLib.Object object) {
+        string? label = null;
+        object.get("label", out label, null);
+        return (label != null)? label.casefold().collate_key() : null;
+    }
+
+    // Every piece of text goes on its own line, so a search doesn't match
+    // across two of them
+    private static string calculate_search_text(GLib.Object object) {
+        var text = new GLib.StringBuilder();
+
+        string? label = null;
+        object.get("label", out label, null);
+        if (label != null)
+            text.append(label).append_c('\n');
 
         if (object.get_class().find_property("description") != null) {
             string? description = null;
             object.get("description", out description, null);
-            if (description != null && (text in description.down()))
-                return true;
+            if (description != null)
+                text.append(description).append_c('\n');
         }
 
-        return false;
+        if (object is Searchable)
+            text.append(((Searchable) object).get_search_text());
+
+        return text.str.casefold();
     }
 
-    private static int compare_items(GLib.Object gobj_a, GLib.Object gobj_b) {
-        string? a_label = null, b_label = null;
+    private void on_item_notify(GLib.Object object, GLib.ParamSpec pspec) {
+        unowned ItemInfo info = this.item_infos.lookup(object);
+        // Items tend to change a few properties in one go, so only look at
+        // the search text again when it's needed
+        info.search_text = null;
+        // ... and a refilter that's running can't tell anymore
+        info.filter_serial = 0;
+        if (this.query_index != null)
+            this.query_index.invalidate(object);
+
+        // A hidden item might match now. That's only looked at once it's
+        // done changing, but also after a narrower search (which otherwise
+        // only looks at what's shown).
+        if (!info.shown && !info.pending_add && !info.pending_change) {
+            info.pending_change = true;
+            this.pending_changed.add(object);
+            schedule_flush();
+        }
+
+        if (pspec.name != "label")
+            return;
+
+        // Move the item to its new place, if it's already shown (which is
+        // found with its old sort key)
+        int old_index = info.shown? find_item(object) : -1;
+        info.sort_key = calculate_sort_key(object);
+        if (old_index < 0)
+            return;
+
+        // Every change is reported right away, so the list always looks
+        // like the listeners were told
+        this.items.remove_index(old_index);
+        int new_index = find_insert_position(object);
+        if (new_index != old_index)
+            items_changed(old_index, 1, 0);
+
+        this.items.insert(new_index, object);
+        if (new_index != old_index)
+            items_changed(new_index, 0, 1);
+    }
 
-        gobj_a.get("label", out a_label, null);
-        gobj_b.get("label", out b_label, null);
+    private int compare_items(GLib.Object gobj_a, GLib.Object gobj_b) {
+        unowned string? a_key = get_item_info(gobj_a).sort_key;
+        unowned string? b_key = get_item_info(gobj_b).sort_key;
 
         // Put (null) labels at the bottom
-        if (a_label == null || b_label == null)
-            return (a_label == null)? 1 : -1;
+        if (a_key == null || b_key == null)
+            return (a_key == b_key)? 0 : (a_key == null)? 1 : -1;
 
-        return compare_labels(a_label, b_label);
+        return GLib.strcmp(a_key, b_key);
     }
 
     public GLib.Object? get_item(uint position) {
@@ -192,35 +579,317 @@ public class Seahorse.ItemList : GLib.Object, GLib.ListModel {
         return this.items.length;
     }
 
+    private bool on_filter_timeout() {
+        this.filter_timeout_id = 0;
+        refilter();
+        return GLib.Source.REMOVE;
+    }
+
     /**
      * Updates the collection.
-     * Automatically called when you change filter_text to another value
+     * Automatically called (after a short delay) when you change filter_text
+     * to another value
      */
     public void refilter() {
-        // First remove all items
-        var len = this.items.length;
-        this.items.remove_range(0, len);
+        if (this.filter_timeout_id != 0) {
+            GLib.Source.remove(this.filter_timeout_id);
+            this.filter_timeout_id = 0;
+        }
+
+        // If the search only got more specific (eg. by typing another
+        // character), only the items that are already shown can match.
+        // That doesn't go for queries though (eg. because of an OR).
+        bool narrower = this.showfilter == this.applied_showfilter
+                     && this.applied_filter_text in this._filter_text
+                     && this.applied_query == null;
+        this.applied_filter_text = this._filter_text;
+        this.applied_showfilter = this.showfilter;
+
+        this.applied_query = Query.parse(this.applied_filter_text);
+        if (this.applied_query != null) {
+            narrower = false;
+            if (this.query_index == null)
+                create_query_index();
+        }
+
+        // A refilter that's still running is outdated now. If it was going
+        // to show more items, it can't be narrowed down from what's shown.
+        // (Replacing it by another one doesn't count as a change.)
+        freeze_notify();
+        if (this.filter_job != null) {
+            narrower = narrower && this.filter_job.narrow;
+            this.filter_job.cancel();
+            set_filter_job(null);
+        }
+
+        if (narrower)
+            narrow_items();
+        else
+            refilter_all_items();
+        thaw_notify();
+
+        debug("%u/%u elements visible after refilter on '%s'",
+              this.items.length, this.base_collection.get_length(),
+              this.applied_filter_text);
+    }
+
+    private void narrow_items() {
+        foreach (unowned GLib.Object object in this.pending_added.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info != null && info.pending_add && !item_matches_filters(object))
+                info.pending_add = false;
+        }
+
+        if (start_filter_job(this.items, true))
+            return;
+
+        remove_unmatched_items();
+    }
+
+    private void refilter_all_items() {
+        // Anything that was still to be added or looked at again is picked
+        // up below
+        flush_removed();
+        foreach (unowned GLib.Object object in this.pending_added.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info != null)
+                info.pending_add = false;
+        }
+        this.pending_added.remove_range(0, this.pending_added.length);
+        foreach (unowned GLib.Object object in this.pending_changed.data) {
+            unowned ItemInfo? info = this.item_infos.lookup(object);
+            if (info != null)
+                info.pending_change = false;
+        }
+        this.pending_changed.remove_range(0, this.pending_changed.length);
+
+        var objects = new GLib.GenericArray<GLib.Object>();
+        foreach (weak GLib.Object obj in this.base_collection.get_objects())
+            objects.add(obj);
+
+        if (start_filter_job(objects, false))
+            return;
+
+        remove_unmatched_items();
+
+        // A query might know which items can match at all
+        var added = new GLib.GenericArray<GLib.Object>();
+        var candidates = (this.applied_query != null)?
+            this.applied_query.get_candidates(this.query_index) : null;
+        if (candidates != null) {
+            foreach (unowned GLib.Object obj in candidates.data) {
+                if (!get_item_info(obj).shown && item_matches_filters(obj))
+                    added.add(obj);
+            }
+        } else {
+            foreach (unowned GLib.Object obj in objects.data) {
+                if (!get_item_info(obj).shown && item_matches_filters(obj))
+                    added.add(obj);
+            }
+        }
 
-        // Add only the ones that match the filter
+        insert_items(added);
+    }
+
+    private void create_query_index() {
+        this.query_index = new QueryIndex();
+
+        // Items are only read once a query needs them
         foreach (weak GLib.Object obj in this.base_collection.get_objects()) {
-            if (item_matches_filters(obj))
-                this.items.add(obj);
+            get_item_info(obj);
+            this.query_index.invalidate(obj);
         }
+    }
 
-        // Sort afterwards
-        this.items.sort(compare_items);
+    // Matches the search text of @objects in the thread pool, if there's
+    // enough of them to be worth it. The list is only updated in
+    // finish_filter_job(), once all threads are done.
+    private bool start_filter_job(GLib.GenericArray<GLib.Object> objects, bool narrow) {
+        if (objects.length < PARALLEL_FILTER_MIN || this.applied_filter_text == ""
+                || this.applied_query != null)
+            return false;
+
+        if (filter_pool == null) {
+            try {
+                filter_pool = new GLib.ThreadPool<FilterChunk>.with_owned_data(
+                    run_filter_chunk, (int) GLib.get_num_processors(), false);
+            } catch (GLib.ThreadError e) {
+                warning("Couldn't create threads to filter with: %s", e.message);
+                return false;
+            }
+        }
+
+        var job = new FilterJob();
+        job.list = this;
+        job.serial = ++this.last_filter_serial;
+        job.narrow = narrow;
+        job.filter_text = this.applied_filter_text;
+        job.objects = new GLib.GenericArray<unowned GLib.Object>(objects.length);
+        job.search_texts = new string?[objects.length];
+        job.matches = new bool[objects.length];
+
+        // Anything that needs the items themselves is done here
+        for (int i = 0; i < objects.length; i++) {
+            unowned GLib.Object object = objects[i];
+            unowned ItemInfo info = get_item_info(object);
+            info.filter_serial = job.serial;
+            job.objects.add(object);
+
+            if (!matches_showfilter(object))
+                continue;
+            if (info.search_text == null)
+                info.search_text = calculate_search_text(object);
+            job.search_texts[i] = info.search_text;
+        }
 
-        // Notify listeners
-        items_changed(0, len, this.items.length);
+        int n_chunks = (objects.length + FILTER_CHUNK_SIZE - 1) / FILTER_CHUNK_SIZE;
+        job.n_chunks_left = n_chunks;
+        this.filter_job = job;
+
+        for (int c = 0; c < n_chunks; c++) {
+            var chunk = new FilterChunk();
+            chunk.job = job;
+            chunk.start = c * FILTER_CHUNK_SIZE;
+            chunk.end = int.min(chunk.start + FILTER_CHUNK_SIZE, objects.length);
+
+            try {
+                filter_pool.add(chunk);
+            } catch (GLib.ThreadError e) {
+                // It's only queued, so just do it ourselves
+                warning("Couldn't queue filter work: %s", e.message);
+                run_filter_chunk(chunk);
+            }
+        }
+
+        return true;
+    }
+
+    // Runs in the thread pool
+    private static void run_filter_chunk(owned FilterChunk chunk) {
+        unowned FilterJob job = chunk.job;
+
+        if (!job.is_cancelled()) {
+            for (int i = chunk.start; i < chunk.end; i++) {
+                unowned string? text = job.search_texts[i];
+                job.matches[i] = (text != null && job.filter_text in text);
+            }
+        }
+
+        if (!GLib.AtomicInt.dec_and_test(ref job.n_chunks_left) || job.is_cancelled())
+            return;
+
+        FilterJob finished = job;
+        GLib.Idle.add(() => {
+            if (finished.list != null)
+                finished.list.finish_filter_job(finished);
+            return GLib.Source.REMOVE;
+        });
+    }
+
+    // Applies the results of the refilter in the thread pool
+    private void finish_filter_job(FilterJob job) {
+        return_if_fail(job == this.filter_job);
+        set_filter_job(null);
+
+        // Items that changed since (or are gone) are matched again below
+        for (int i = 0; i < job.objects.length; i++) {
+            unowned ItemInfo? info = this.item_infos.lookup(job.objects[i]);
+            if (info != null && info.filter_serial == job.serial)
+                info.filter_match = job.matches[i];
+        }
+
+        remove_items_where((object) => {
+            if (item_matched_filter_job(object, job.serial))
+                return false;
+            get_item_info(object).shown = false;
+            return true;
+        });
+
+        if (!job.narrow) {
+            // Items that were added since are taken care of already
+            var added = new GLib.GenericArray<GLib.Object>();
+            foreach (weak GLib.Object obj in this.base_collection.get_objects()) {
+                unowned ItemInfo info = get_item_info(obj);
+                if (!info.shown && !info.pending_add && item_matched_filter_job(obj, job.serial))
+                    added.add(obj);
+            }
+            insert_items(added);
+        }
 
         debug("%u/%u elements visible after refilter on '%s'",
               this.items.length, this.base_collection.get_length(),
-              this._filter_text);
+              this.applied_filter_text);
     }
 
-    // Compares 2 labels in an intuitive way
-    // (case-insensitive; with respect to the user's locale)
-    private static int compare_labels(string a_label, string b_label) {
-        return a_label.casefold().collate(b_label.casefold());
+    private bool item_matched_filter_job(GLib.Object object, uint serial) {
+        unowned ItemInfo info = get_item_info(object);
+        if (info.filter_serial == serial)
+            return info.filter_match;
+        return item_matches_filters(object);
+    }
+
+    private void remove_unmatched_items() {
+        remove_items_where((object) => {
+            if (item_matches_filters(object))
+                return false;
+            get_item_info(object).shown = false;
+            return true;
+        });
+    }
+
+    private delegate bool ItemPredicate(GLib.Object object);
+
+    // Removes the items for which @predicate returns true. Every range of
+    // neighbouring items is reported on its own, starting from the back so
+    // the positions stay valid. The predicate is called once for every item.
+    private void remove_items_where(ItemPredicate predicate) {
+        int end = this.items.length;
+
+        while (end > 0) {
+            while (end > 0 && !predicate(this.items[end - 1]))
+                end--;
+            if (end == 0)
+                break;
+
+            // The last item of the range matched already
+            int start = end - 1;
+            while (start > 0 && predicate(this.items[start - 1]))
+                start--;
+
+            this.items.remove_range(start, end - start);
+            items_changed(start, end - start, 0);
+
+            // And the one before it didn't
+            end = start - 1;
+        }
+    }
+
+    // Merges the (sorted) @added items into the list. That's reported as a
+    // single change, from the first to the last new item, since a listener
+    // has to find the list as it's told after every change.
+    private void merge_items(GLib.GenericArray<GLib.Object> added) {
+        var merged = new GLib.GenericArray<GLib.Object>(this.items.length + added.length);
+        int first = -1, last = -1;
+        int i = 0, j = 0;
+
+        while (j < added.length) {
+            if (i < this.items.length && compare_items(this.items[i], added[j]) <= 0) {
+                merged.add(this.items[i++]);
+                continue;
+            }
+
+            if (first < 0)
+                first = merged.length;
+            while (j < added.length
+                   && (i == this.items.length || compare_items(added[j], this.items[i]) < 0))
+                merged.add(added[j++]);
+            last = merged.length;
+        }
+        while (i < this.items.length)
+            merged.add(this.items[i++]);
+
+        this.items = merged;
+        if (first >= 0)
+            items_changed(first, last - first - added.length, last - first);
     }
 }
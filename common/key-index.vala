@@ -0,0 +1,157 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Finds keys (or anything else with a key ID or fingerprint) across all
+ * backends, without walking through all of their places.
+ *
+ * The index follows the collections that are added to it, and the
+ * collections in those: every {@link Backend} is added when it's
+ * registered, and with it all of its places.
+ */
+public class Seahorse.KeyIndex : GLib.Object {
+
+    private static KeyIndex? _default = null;
+
+    /** The key IDs and fingerprints of the items */
+    private QueryIndex index = new QueryIndex();
+
+    private GLib.HashTable<Gcr.Collection, unowned Gcr.Collection> collections
+        = new GLib.HashTable<Gcr.Collection, unowned Gcr.Collection>(GLib.direct_hash, GLib.direct_equal);
+
+    // An item can be in more than one collection, so it's only gone once
+    // it left all of them
+    [Compact]
+    private class Item {
+        public uint n_collections;
+    }
+    private GLib.HashTable<GLib.Object, Item> items
+        = new GLib.HashTable<GLib.Object, Item>(GLib.direct_hash, GLib.direct_equal);
+
+    public static KeyIndex get_default() {
+        if (_default == null)
+            _default = new KeyIndex();
+        return _default;
+    }
+
+    ~KeyIndex() {
+        foreach (unowned Gcr.Collection collection in this.collections.get_keys()) {
+            collection.added.disconnect(on_added);
+            collection.removed.disconnect(on_removed);
+        }
+        foreach (unowned GLib.Object object in this.items.get_keys())
+            object.notify.disconnect(on_item_notify);
+    }
+
+    /** Indexes the items of @collection, and of the collections in it */
+    public void add_collection(Gcr.Collection collection) {
+        if (this.collections.contains(collection))
+            return;
+
+        this.collections.insert(collection, collection);
+        collection.added.connect(on_added);
+        collection.removed.connect(on_removed);
+
+        foreach (weak GLib.Object object in collection.get_objects())
+            on_added(collection, object);
+    }
+
+    /** Forgets about @collection and its items again */
+    public void remove_collection(Gcr.Collection collection) {
+        if (!this.collections.contains(collection))
+            return;
+
+        collection.added.disconnect(on_added);
+        collection.removed.disconnect(on_removed);
+        foreach (weak GLib.Object object in collection.get_objects())
+            on_removed(collection, object);
+
+        this.collections.remove(collection);
+    }
+
+    /**
+     * Finds the items with a (sub)key that has @keyid, either as a whole or
+     * as its last 8 digits (a short key ID). Spaces, colons, case and a 0x
+     * in front don't matter.
+     */
+    public GLib.GenericArray<GLib.Object> find_keyid(string keyid) {
+        return to_owned(this.index.find_keyid(QueryIndex.normalize_id(keyid)));
+    }
+
+    /** Finds the items with a (sub)key that has @fingerprint */
+    public GLib.GenericArray<GLib.Object> find_fingerprint(string fingerprint) {
+        return to_owned(this.index.find_fingerprint(QueryIndex.normalize_id(fingerprint)));
+    }
+
+    /** Finds the items with @id as a fingerprint, or otherwise as a key ID */
+    public GLib.GenericArray<GLib.Object> find(string id) {
+        var found = find_fingerprint(id);
+        if (found.length == 0)
+            found = find_keyid(id);
+        return found;
+    }
+
+    private static GLib.GenericArray<GLib.Object> to_owned(GLib.GenericArray<unowned GLib.Object> objects) {
+        var result = new GLib.GenericArray<GLib.Object>(objects.length);
+        foreach (unowned GLib.Object object in objects.data)
+            result.add(object);
+        return result;
+    }
+
+    private void on_added(Gcr.Collection collection, GLib.Object object) {
+        // Places are collections of their own
+        if (object is Gcr.Collection) {
+            add_collection((Gcr.Collection) object);
+            return;
+        }
+
+        unowned Item? item = this.items.lookup(object);
+        if (item != null) {
+            item.n_collections++;
+            return;
+        }
+
+        var new_item = new Item();
+        new_item.n_collections = 1;
+        this.items.insert(object, (owned) new_item);
+        object.notify.connect(on_item_notify);
+
+        // It's only read once somebody looks for a key
+        this.index.invalidate(object);
+    }
+
+    private void on_removed(Gcr.Collection collection, GLib.Object object) {
+        if (object is Gcr.Collection) {
+            remove_collection((Gcr.Collection) object);
+            return;
+        }
+
+        unowned Item? item = this.items.lookup(object);
+        if (item == null || --item.n_collections > 0)
+            return;
+
+        object.notify.disconnect(on_item_notify);
+        this.index.remove(object);
+        this.items.remove(object);
+    }
+
+    private void on_item_notify(GLib.Object object, GLib.ParamSpec pspec) {
+        this.index.invalidate(object);
+    }
+}
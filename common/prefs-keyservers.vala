@@ -33,6 +33,8 @@ public class Seahorse.PrefsKeyservers : Hdy.PreferencesPage {
     private unowned Gtk.CheckButton auto_retrieve;
     [GtkChild]
     private unowned Gtk.CheckButton auto_sync;
+    [GtkChild]
+    private unowned Gtk.CheckButton auto_refresh;
 
     public PrefsKeyservers() {
         var model = Pgp.Backend.get().get_remotes();
@@ -51,6 +53,8 @@ public class Seahorse.PrefsKeyservers : Hdy.PreferencesPage {
                                     SettingsBindFlags.DEFAULT);
         AppSettings.instance().bind("server-auto-publish", this.auto_sync, "active",
                                     SettingsBindFlags.DEFAULT);
+        AppSettings.instance().bind("server-auto-refresh", this.auto_refresh, "active",
+                                    SettingsBindFlags.DEFAULT);
     }
 
     private class KeyServerRow : Gtk.ListBoxRow {
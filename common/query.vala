@@ -0,0 +1,862 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * A search that looks at specific fields of the items, rather than just at
+ * their text. For example:
+ *
+ * {{{
+ *   email:example.org -is:expired
+ *   (type:ssh OR trust>=full) AND expires<2025-01-01
+ * }}}
+ *
+ * The fields are:
+ *
+ *  * email:TEXT - one of the email addresses contains TEXT
+ *  * keyid:ID - one of the (sub)keys has this key ID, in its short or long form
+ *  * fpr:FINGERPRINT - one of the (sub)keys has this fingerprint
+ *  * type:TYPE - the kind of item, like "pgp", "ssh" or "password"
+ *  * trust:LEVEL - the owner trust: "unknown", "never", "marginal", "full" or "ultimate"
+ *  * expires:DATE - expires on that day (as YYYY-MM-DD), or "never"
+ *  * is:FLAG - "expired", "revoked", "disabled", "trusted" or "personal"
+ *
+ * The trust and expiry date can also be compared with <, <=, > and >=.
+ * Words without a field are looked for in the search text, like any search.
+ *
+ * All terms have to match, unless there's an OR in between. NOT (or a "-"
+ * in front of a term) turns a term around, and parentheses group terms.
+ */
+public class Seahorse.Query {
+
+    /** Tells whether @object can be found with @text */
+    public delegate bool TextMatcher(GLib.Object object, string text);
+
+    private enum Field {
+        EMAIL,
+        KEYID,
+        FPR,
+        TYPE,
+        TRUST,
+        EXPIRES,
+        IS;
+
+        public static bool from_string(string name, out Field field) {
+            switch (name) {
+                case "email":
+                    field = Field.EMAIL;
+                    return true;
+                case "keyid":
+                    field = Field.KEYID;
+                    return true;
+                case "fpr":
+                    field = Field.FPR;
+                    return true;
+                case "type":
+                    field = Field.TYPE;
+                    return true;
+                case "trust":
+                    field = Field.TRUST;
+                    return true;
+                case "expires":
+                    field = Field.EXPIRES;
+                    return true;
+                case "is":
+                    field = Field.IS;
+                    return true;
+                default:
+                    field = Field.EMAIL;
+                    return false;
+            }
+        }
+    }
+
+    private abstract class Term {
+        public abstract bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches);
+
+        /**
+         * Returns the only items that can match (or null if any item can),
+         * if the index can tell.
+         */
+        public virtual GLib.GenericArray<unowned GLib.Object>? get_candidates(QueryIndex index) {
+            return null;
+        }
+    }
+
+    private class TextTerm : Term {
+        public string text;
+
+        public override bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+            return text_matches(object, this.text);
+        }
+    }
+
+    private class NotTerm : Term {
+        public Term term;
+
+        public override bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+            return !this.term.matches(object, index, text_matches);
+        }
+    }
+
+    private class AndTerm : Term {
+        public Term left;
+        public Term right;
+
+        public override bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+            return this.left.matches(object, index, text_matches)
+                && this.right.matches(object, index, text_matches);
+        }
+
+        public override GLib.GenericArray<unowned GLib.Object>? get_candidates(QueryIndex index) {
+            var left = this.left.get_candidates(index);
+            var right = this.right.get_candidates(index);
+            if (left == null || right == null)
+                return (left != null)? left : right;
+
+            // Either one will do, since everything is matched afterwards
+            return (left.length <= right.length)? left : right;
+        }
+    }
+
+    private class OrTerm : Term {
+        public Term left;
+        public Term right;
+
+        public override bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+            return this.left.matches(object, index, text_matches)
+                || this.right.matches(object, index, text_matches);
+        }
+
+        public override GLib.GenericArray<unowned GLib.Object>? get_candidates(QueryIndex index) {
+            var left = this.left.get_candidates(index);
+            if (left == null)
+                return null;
+            var right = this.right.get_candidates(index);
+            if (right == null)
+                return null;
+
+            var seen = new GLib.GenericSet<unowned GLib.Object>(GLib.direct_hash, GLib.direct_equal);
+            foreach (unowned GLib.Object object in left.data)
+                seen.add(object);
+            foreach (unowned GLib.Object object in right.data) {
+                if (!seen.contains(object)) {
+                    seen.add(object);
+                    left.add(object);
+                }
+            }
+            return left;
+        }
+    }
+
+    private class FieldTerm : Term {
+        public Field field;
+        public string value;
+        public Flags flag;
+        // The range of trust levels or expiry dates that match
+        public int64 low;
+        public int64 high;
+
+        public override bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+            unowned QueryIndex.Entry entry = index.get_entry(object);
+
+            switch (this.field) {
+                case Field.EMAIL:
+                    foreach (unowned string email in entry.emails) {
+                        if (this.value in email)
+                            return true;
+                    }
+                    return false;
+                case Field.KEYID:
+                    return this.value in entry.keyids;
+                case Field.FPR:
+                    return this.value in entry.fingerprints;
+                case Field.TYPE:
+                    return this.value in entry.types;
+                case Field.TRUST:
+                    return entry.has_trust && this.low <= entry.trust && entry.trust <= this.high;
+                case Field.EXPIRES:
+                    return entry.has_expires && this.low <= entry.expires && entry.expires <= this.high;
+                case Field.IS:
+                    return this.flag in entry.flags;
+            }
+
+            return_val_if_reached(false);
+        }
+
+        public override GLib.GenericArray<unowned GLib.Object>? get_candidates(QueryIndex index) {
+            switch (this.field) {
+                case Field.KEYID:
+                    return index.find_keyid(this.value);
+                case Field.FPR:
+                    return index.find_fingerprint(this.value);
+                case Field.EXPIRES:
+                    return index.find_expiring(this.low, this.high);
+                default:
+                    return null;
+            }
+        }
+    }
+
+    private class Token {
+        public string text;
+        // Parentheses and quoted words are never operators or fields
+        public bool is_paren;
+        public bool quoted;
+
+        public bool is_operator(string name) {
+            return !this.is_paren && !this.quoted && this.text == name;
+        }
+
+        public bool is_closing() {
+            return this.is_paren && this.text == ")";
+        }
+    }
+
+    private Term root;
+
+    private Query(Term root) {
+        this.root = root;
+    }
+
+    /**
+     * Parses the (casefolded) @text. Returns null if it isn't a query, i.e.
+     * if it doesn't use any fields or doesn't parse, so it's better searched
+     * for as a whole.
+     */
+    public static Query? parse(string text) {
+        var parser = new Parser(tokenize(text));
+        var root = parser.parse();
+        if (root == null || !parser.has_fields)
+            return null;
+        return new Query(root);
+    }
+
+    /** Whether @object matches the query */
+    public bool matches(GLib.Object object, QueryIndex index, TextMatcher text_matches) {
+        return this.root.matches(object, index, text_matches);
+    }
+
+    /**
+     * Returns the only items that can match the query, if the index knows
+     * that already (or null if every item needs to be matched).
+     */
+    public GLib.GenericArray<unowned GLib.Object>? get_candidates(QueryIndex index) {
+        return this.root.get_candidates(index);
+    }
+
+    private static GLib.GenericArray<Token> tokenize(string text) {
+        var tokens = new GLib.GenericArray<Token>();
+
+        int i = 0;
+        while (i < text.length) {
+            char c = text[i];
+            if (c.isspace()) {
+                i++;
+                continue;
+            }
+
+            var token = new Token();
+            if (c == '(' || c == ')') {
+                token.text = c.to_string();
+                token.is_paren = true;
+                tokens.add(token);
+                i++;
+                continue;
+            }
+
+            // Anything up to the next space or parenthesis, but quotes can
+            // have those in between
+            var word = new GLib.StringBuilder();
+            while (i < text.length && !text[i].isspace() && text[i] != '(' && text[i] != ')') {
+                if (text[i] != '"') {
+                    word.append_c(text[i++]);
+                    continue;
+                }
+
+                token.quoted = token.quoted || word.len == 0;
+                for (i++; i < text.length && text[i] != '"'; i++)
+                    word.append_c(text[i]);
+                i++;
+            }
+            token.text = word.str;
+            tokens.add(token);
+        }
+
+        return tokens;
+    }
+
+    private class Parser {
+        private GLib.GenericArray<Token> tokens;
+        private int pos = 0;
+        private bool failed = false;
+        public bool has_fields = false;
+
+        public Parser(GLib.GenericArray<Token> tokens) {
+            this.tokens = tokens;
+        }
+
+        public Term? parse() {
+            if (this.tokens.length == 0)
+                return null;
+
+            var term = parse_or();
+            // Anything left means there was a parenthesis too many
+            if (this.pos < this.tokens.length || this.failed)
+                return null;
+            return term;
+        }
+
+        private unowned Token? peek() {
+            return (this.pos < this.tokens.length)? this.tokens[this.pos] : null;
+        }
+
+        private Term parse_or() {
+            var term = parse_and();
+            while (peek() != null && peek().is_operator("or")) {
+                this.pos++;
+                var or_term = new OrTerm();
+                or_term.left = term;
+                or_term.right = parse_and();
+                term = or_term;
+            }
+            return term;
+        }
+
+        private Term parse_and() {
+            var term = parse_not();
+            while (peek() != null && !peek().is_operator("or") && !peek().is_closing()) {
+                if (peek().is_operator("and"))
+                    this.pos++;
+                var and_term = new AndTerm();
+                and_term.left = term;
+                and_term.right = parse_not();
+                term = and_term;
+            }
+            return term;
+        }
+
+        private Term parse_not() {
+            if (peek() != null && peek().is_operator("not")) {
+                this.pos++;
+                var not_term = new NotTerm();
+                not_term.term = parse_not();
+                return not_term;
+            }
+            return parse_primary();
+        }
+
+        private Term parse_primary() {
+            unowned Token? token = peek();
+            if (token == null || token.is_closing())
+                return fail();
+            this.pos++;
+
+            if (token.is_paren) {
+                var term = parse_or();
+                token = peek();
+                if (token == null || !token.is_closing())
+                    return fail();
+                this.pos++;
+                return term;
+            }
+
+            if (!token.quoted && token.text.length > 1 && token.text[0] == '-') {
+                var not_term = new NotTerm();
+                not_term.term = parse_word(token.text.substring(1), false);
+                return not_term;
+            }
+            return parse_word(token.text, token.quoted);
+        }
+
+        private Term parse_word(string word, bool quoted) {
+            int sep = -1;
+            for (int i = 0; i < word.length && sep < 0 && !quoted; i++) {
+                if (word[i] == ':' || word[i] == '<' || word[i] == '>' || word[i] == '=')
+                    sep = i;
+            }
+
+            Field field;
+            if (sep <= 0 || !Field.from_string(word.substring(0, sep), out field)) {
+                var text_term = new TextTerm();
+                text_term.text = word;
+                return text_term;
+            }
+
+            this.has_fields = true;
+            string comparison = word.substring(sep, (word[sep + 1] == '=')? 2 : 1);
+            var term = make_field_term(field, comparison, word.substring(sep + comparison.length));
+            return (term != null)? term : fail();
+        }
+
+        private Term fail() {
+            this.failed = true;
+            var term = new TextTerm();
+            term.text = "";
+            return term;
+        }
+    }
+
+    private static FieldTerm? make_field_term(Field field, string comparison, string value) {
+        if (value == "")
+            return null;
+
+        var term = new FieldTerm();
+        term.field = field;
+
+        switch (field) {
+            case Field.EMAIL:
+            case Field.TYPE:
+                term.value = value;
+                break;
+            case Field.KEYID:
+            case Field.FPR:
+                term.value = QueryIndex.normalize_id(value);
+                break;
+            case Field.TRUST:
+                int level;
+                if (!parse_trust(value, out level))
+                    return null;
+                return set_range(term, comparison, level, level + 1)? term : null;
+            case Field.EXPIRES:
+                if (value == "never") {
+                    term.low = term.high = QueryIndex.NEVER;
+                    return (comparison == ":" || comparison == "=")? term : null;
+                }
+                int64 day_start, day_end;
+                if (!parse_day(value, out day_start, out day_end))
+                    return null;
+                return set_range(term, comparison, day_start, day_end)? term : null;
+            case Field.IS:
+                Flags flag;
+                if (!parse_flag(value, out flag))
+                    return null;
+                term.flag = flag;
+                break;
+        }
+
+        // Only numbers can be compared
+        return (comparison == ":" || comparison == "=")? term : null;
+    }
+
+    // Sets the range of @term to whatever compares to [@start, @end)
+    private static bool set_range(FieldTerm term, string comparison, int64 start, int64 end) {
+        switch (comparison) {
+            case ":":
+            case "=":
+                term.low = start;
+                term.high = end - 1;
+                return true;
+            case "<":
+                term.low = int64.MIN;
+                term.high = start - 1;
+                return true;
+            case "<=":
+                term.low = int64.MIN;
+                term.high = end - 1;
+                return true;
+            case ">":
+                term.low = end;
+                term.high = int64.MAX;
+                return true;
+            case ">=":
+                term.low = start;
+                term.high = int64.MAX;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    private static bool parse_trust(string value, out int level) {
+        switch (value) {
+            case "unknown":
+                level = Validity.UNKNOWN;
+                return true;
+            case "never":
+                level = Validity.NEVER;
+                return true;
+            case "marginal":
+                level = Validity.MARGINAL;
+                return true;
+            case "full":
+                level = Validity.FULL;
+                return true;
+            case "ultimate":
+                level = Validity.ULTIMATE;
+                return true;
+            default:
+                level = Validity.UNKNOWN;
+                return false;
+        }
+    }
+
+    // Parses a YYYY-MM-DD date, as the (local) time it starts and ends
+    private static bool parse_day(string value, out int64 start, out int64 end) {
+        start = end = 0;
+
+        int year, month, day;
+        if (value.length != 10 || value.scanf("%4d-%2d-%2d", out year, out month, out day) != 3)
+            return false;
+        if (!GLib.Date.valid_dmy((GLib.DateDay) day, (GLib.DateMonth) month, (GLib.DateYear) year))
+            return false;
+
+        var date = new GLib.DateTime.local(year, month, day, 0, 0, 0);
+        start = date.to_unix();
+        end = date.add_days(1).to_unix();
+        return true;
+    }
+
+    private static bool parse_flag(string value, out Flags flag) {
+        switch (value) {
+            case "expired":
+                flag = Flags.EXPIRED;
+                return true;
+            case "revoked":
+                flag = Flags.REVOKED;
+                return true;
+            case "disabled":
+                flag = Flags.DISABLED;
+                return true;
+            case "trusted":
+                flag = Flags.TRUSTED;
+                return true;
+            case "personal":
+                flag = Flags.PERSONAL;
+                return true;
+            default:
+                flag = Flags.NONE;
+                return false;
+        }
+    }
+}
+
+/**
+ * What a {@link Query} looks at for every item, so it's only read once (and
+ * again when the item changes).
+ *
+ * The fields that are looked up, rather than matched, are indexed too: the
+ * key IDs and fingerprints in a hash table, and the expiry dates in an
+ * array that's sorted once it's needed.
+ */
+public class Seahorse.QueryIndex {
+
+    /** The expiry date of items that don't expire */
+    public const int64 NEVER = int64.MAX;
+
+    [Compact]
+    public class Entry {
+        public string[] emails;
+        // In the form of normalize_id()
+        public string[] keyids;
+        public string[] fingerprints;
+        public string[] types;
+        public bool has_trust;
+        public int64 trust;
+        public bool has_expires;
+        public int64 expires;
+        public Flags flags;
+    }
+
+    private GLib.HashTable<unowned GLib.Object, Entry> entries
+        = new GLib.HashTable<unowned GLib.Object, Entry>(GLib.direct_hash, GLib.direct_equal);
+
+    /** Items that need to be read (again) */
+    private GLib.HashTable<unowned GLib.Object, unowned GLib.Object> stale
+        = new GLib.HashTable<unowned GLib.Object, unowned GLib.Object>(GLib.direct_hash, GLib.direct_equal);
+
+    private GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>> by_keyid
+        = new GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>>(GLib.str_hash, GLib.str_equal);
+    private GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>> by_fingerprint
+        = new GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>>(GLib.str_hash, GLib.str_equal);
+
+    private GLib.GenericArray<unowned GLib.Object> by_expiry = new GLib.GenericArray<unowned GLib.Object>();
+    private bool by_expiry_sorted = true;
+
+    /**
+     * Marks @object as changed (or new), so it's read again once it's
+     * needed. The index doesn't keep a reference to it, so it should be
+     * removed again with remove().
+     */
+    public void invalidate(GLib.Object object) {
+        unindex(object);
+        this.stale.add(object);
+    }
+
+    /** Forgets about @object */
+    public void remove(GLib.Object object) {
+        unindex(object);
+        this.stale.remove(object);
+    }
+
+    /** Returns what's known about @object */
+    public unowned Entry get_entry(GLib.Object object) {
+        unowned Entry? entry = this.entries.lookup(object);
+        if (entry == null) {
+            this.stale.remove(object);
+            entry = index(object);
+        }
+        return entry;
+    }
+
+    /** Returns the items that have a (sub)key with @keyid */
+    public GLib.GenericArray<unowned GLib.Object> find_keyid(string keyid) {
+        return find_in(this.by_keyid, keyid);
+    }
+
+    /** Returns the items that have a (sub)key with @fingerprint */
+    public GLib.GenericArray<unowned GLib.Object> find_fingerprint(string fingerprint) {
+        return find_in(this.by_fingerprint, fingerprint);
+    }
+
+    /** Returns the items that expire between @low and @high (inclusive) */
+    public GLib.GenericArray<unowned GLib.Object> find_expiring(int64 low, int64 high) {
+        flush_stale();
+
+        if (!this.by_expiry_sorted) {
+            this.by_expiry.remove_range(0, this.by_expiry.length);
+            this.entries.foreach((object, entry) => {
+                if (entry.has_expires)
+                    this.by_expiry.add(object);
+            });
+            this.by_expiry.sort_with_data((a, b) => {
+                return compare_int64(this.entries.lookup(a).expires, this.entries.lookup(b).expires);
+            });
+            this.by_expiry_sorted = true;
+        }
+
+        int start = find_first_expiring(low);
+        int end = (high == int64.MAX)? this.by_expiry.length : find_first_expiring(high + 1);
+
+        var found = new GLib.GenericArray<unowned GLib.Object>(int.max(end - start, 0));
+        for (int i = start; i < end; i++)
+            found.add(this.by_expiry[i]);
+        return found;
+    }
+
+    // Finds the first item in by_expiry that doesn't expire before @time
+    private int find_first_expiring(int64 time) {
+        int low = 0, high = this.by_expiry.length;
+
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (this.entries.lookup(this.by_expiry[mid]).expires < time)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        return low;
+    }
+
+    private static int compare_int64(int64 a, int64 b) {
+        return (a < b)? -1 : (a > b)? 1 : 0;
+    }
+
+    private GLib.GenericArray<unowned GLib.Object> find_in(GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>> table,
+                                                           string key) {
+        flush_stale();
+
+        var found = new GLib.GenericArray<unowned GLib.Object>();
+        unowned GLib.GenericArray<unowned GLib.Object>? objects = table.lookup(key);
+        if (objects != null) {
+            foreach (unowned GLib.Object object in objects.data)
+                found.add(object);
+        }
+        return found;
+    }
+
+    private void flush_stale() {
+        foreach (unowned GLib.Object object in this.stale.get_keys())
+            index(object);
+        this.stale.remove_all();
+    }
+
+    private unowned Entry index(GLib.Object object) {
+        var entry = read_entry(object);
+
+        foreach (unowned string keyid in entry.keyids)
+            add_to(this.by_keyid, keyid, object);
+        foreach (unowned string fingerprint in entry.fingerprints)
+            add_to(this.by_fingerprint, fingerprint, object);
+        if (entry.has_expires)
+            this.by_expiry_sorted = false;
+
+        unowned Entry result = entry;
+        this.entries.insert(object, (owned) entry);
+        return result;
+    }
+
+    private void unindex(GLib.Object object) {
+        unowned Entry? entry = this.entries.lookup(object);
+        if (entry == null)
+            return;
+
+        foreach (unowned string keyid in entry.keyids)
+            remove_from(this.by_keyid, keyid, object);
+        foreach (unowned string fingerprint in entry.fingerprints)
+            remove_from(this.by_fingerprint, fingerprint, object);
+        if (entry.has_expires)
+            this.by_expiry_sorted = false;
+
+        this.entries.remove(object);
+    }
+
+    private static void add_to(GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>> table,
+                               string key, GLib.Object object) {
+        unowned GLib.GenericArray<unowned GLib.Object>? objects = table.lookup(key);
+        if (objects == null) {
+            var new_objects = new GLib.GenericArray<unowned GLib.Object>();
+            objects = new_objects;
+            table.insert(key, (owned) new_objects);
+        }
+        objects.add(object);
+    }
+
+    private static void remove_from(GLib.HashTable<string, GLib.GenericArray<unowned GLib.Object>> table,
+                                    string key, GLib.Object object) {
+        unowned GLib.GenericArray<unowned GLib.Object>? objects = table.lookup(key);
+        if (objects == null)
+            return;
+
+        objects.remove_fast(object);
+        if (objects.length == 0)
+            table.remove(key);
+    }
+
+    /**
+     * Key IDs and fingerprints are written in a lot of ways, so they're only
+     * compared without spaces or colons, a 0x in front, or case.
+     */
+    public static string normalize_id(string id) {
+        var normalized = new GLib.StringBuilder();
+        for (int i = 0; i < id.length; i++) {
+            if (!id[i].isspace() && id[i] != ':')
+                normalized.append_c(id[i].tolower());
+        }
+
+        if (normalized.str.has_prefix("0x"))
+            normalized.erase(0, 2);
+        return normalized.str;
+    }
+
+    private static Entry read_entry(GLib.Object object) {
+        var entry = new Entry();
+        unowned Searchable? searchable = object as Searchable;
+
+        entry.emails = read_field(searchable, "email");
+
+        // Short key IDs are the last 8 digits of the long ones
+        string[] keyids = {};
+        foreach (unowned string keyid in read_field(searchable, "keyid")) {
+            var normalized = normalize_id(keyid);
+            add_unique(ref keyids, normalized);
+            if (normalized.length > 8)
+                add_unique(ref keyids, normalized.substring(normalized.length - 8));
+        }
+        entry.keyids = keyids;
+
+        string[] fingerprints = read_field(searchable, "fpr");
+        if (fingerprints.length == 0 && object.get_class().find_property("fingerprint") != null) {
+            string? fingerprint = null;
+            object.get("fingerprint", out fingerprint, null);
+            if (fingerprint != null && fingerprint != "")
+                fingerprints += fingerprint;
+        }
+        string[] normalized_fingerprints = {};
+        foreach (unowned string fingerprint in fingerprints)
+            add_unique(ref normalized_fingerprints, normalize_id(fingerprint));
+        entry.fingerprints = normalized_fingerprints;
+
+        entry.types = read_field(searchable, "type");
+        if (entry.types.length == 0 && object is Seahorse.Object
+                && ((Seahorse.Object) object).usage == Usage.CREDENTIALS)
+            entry.types = { "password" };
+
+        int trust;
+        entry.has_trust = read_int(object, "trust", out trust);
+        entry.trust = trust;
+        entry.has_expires = read_expires(object, out entry.expires);
+
+        if (object.get_class().find_property("object-flags") != null)
+            object.get("object-flags", out entry.flags, null);
+
+        return entry;
+    }
+
+    private static string[] read_field(Searchable? searchable, string field) {
+        string[] values = {};
+        if (searchable == null)
+            return values;
+
+        string[]? field_values = searchable.get_search_field(field);
+        if (field_values == null)
+            return values;
+        foreach (unowned string value in field_values)
+            values += value.casefold();
+        return values;
+    }
+
+    private static void add_unique(ref string[] values, string value) {
+        if (!(value in values))
+            values += value;
+    }
+
+    private static bool read_int(GLib.Object object, string property, out int number) {
+        number = 0;
+
+        unowned GLib.ParamSpec? pspec = object.get_class().find_property(property);
+        if (pspec == null)
+            return false;
+
+        var value = GLib.Value(pspec.value_type);
+        object.get_property(property, ref value);
+        var int_value = GLib.Value(typeof(int));
+        if (!value.transform(ref int_value))
+            return false;
+
+        number = int_value.get_int();
+        return true;
+    }
+
+    // Items either have a date (if any) or a timestamp (0 if never)
+    private static bool read_expires(GLib.Object object, out int64 expires) {
+        expires = NEVER;
+
+        unowned GLib.ParamSpec? pspec = object.get_class().find_property("expires");
+        if (pspec == null)
+            return false;
+
+        var value = GLib.Value(pspec.value_type);
+        object.get_property("expires", ref value);
+
+        if (pspec.value_type == typeof(GLib.DateTime)) {
+            unowned GLib.DateTime? date = (GLib.DateTime?) value.get_boxed();
+            if (date != null)
+                expires = date.to_unix();
+            return true;
+        }
+
+        var int64_value = GLib.Value(typeof(int64));
+        if (!value.transform(ref int64_value))
+            return false;
+        if (int64_value.get_int64() != 0)
+            expires = int64_value.get_int64();
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * An object that can be found by more than its label and description, like
+ * the key IDs or email addresses of a key.
+ */
+public interface Seahorse.Searchable : GLib.Object {
+
+    /**
+     * Returns the extra text that this object can be found with, as lines of
+     * text. The result should only change when a property of this object
+     * changes.
+     */
+    public abstract string get_search_text();
+
+    /**
+     * Returns the values of @field that a {@link Query} can look for (like
+     * the email addresses for "email"), or null if this object doesn't have
+     * such a field. The fields are "email", "keyid", "fpr" and "type".
+     */
+    [CCode (array_length = false, array_null_terminated = true)]
+    public virtual string[]? get_search_field(string field) {
+        return null;
+    }
+}
@@ -0,0 +1,434 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+void main(string[] args) {
+    Test.init(ref args);
+
+    Test.add_func("/item-list/sort", test_item_list_sort);
+    Test.add_func("/item-list/add", test_item_list_add);
+    Test.add_func("/item-list/remove", test_item_list_remove);
+    Test.add_func("/item-list/label-changed", test_item_list_label_changed);
+    Test.add_func("/item-list/filter", test_item_list_filter);
+    Test.add_func("/item-list/filter-delay", test_item_list_filter_delay);
+    Test.add_func("/item-list/filter-searchable", test_item_list_filter_searchable);
+    Test.add_func("/item-list/filter-parallel", test_item_list_filter_parallel);
+    Test.add_func("/item-list/query", test_item_list_query);
+
+    if (Test.perf()) {
+        Test.add_func("/item-list/perf/sort", test_item_list_perf_sort);
+        Test.add_func("/item-list/perf/filter", test_item_list_perf_filter);
+    }
+
+    Test.run();
+}
+
+private Seahorse.Object make_item(string label) {
+    var item = new Seahorse.Object();
+    item.label = label;
+    return item;
+}
+
+private class TestKey : Seahorse.Object, Seahorse.Searchable {
+    public string keyid { get; set; default = ""; }
+    public string email { get; set; default = ""; }
+    public uint trust { get; set; default = 0; }
+    public DateTime? expires { get; set; default = null; }
+
+    public TestKey(string label, string keyid) {
+        GLib.Object(label: label, keyid: keyid);
+    }
+
+    public string get_search_text() {
+        return this.keyid + "\n";
+    }
+
+    [CCode (array_length = false, array_null_terminated = true)]
+    public string[]? get_search_field(string field) {
+        switch (field) {
+            case "email":
+                return { this.email };
+            case "keyid":
+                return { this.keyid };
+            case "type":
+                return { "pgp" };
+            default:
+                return null;
+        }
+    }
+}
+
+private void flush_main_context() {
+    while (MainContext.default().iteration(false));
+}
+
+private void wait_for_refilter(Seahorse.ItemList list) {
+    while (list.refiltering)
+        MainContext.default().iteration(true);
+}
+
+private void assert_labels(Seahorse.ItemList list, string[] expected) {
+    assert_true(list.get_n_items() == expected.length);
+    for (uint i = 0; i < expected.length; i++) {
+        var item = (Seahorse.Object) list.get_item(i);
+        assert_true(item.label == expected[i]);
+    }
+}
+
+private void test_item_list_sort() {
+    var collection = new Gcr.SimpleCollection();
+    collection.add(make_item("banana"));
+    collection.add(make_item("Cherry"));
+    collection.add(make_item("apple"));
+
+    var list = new Seahorse.ItemList(collection);
+    assert_labels(list, { "apple", "banana", "Cherry" });
+}
+
+private void test_item_list_add() {
+    var collection = new Gcr.SimpleCollection();
+    collection.add(make_item("banana"));
+    collection.add(make_item("date"));
+    var list = new Seahorse.ItemList(collection);
+
+    // The list always has as many items as it said it has
+    uint n_changes = 0;
+    uint n_items = list.get_n_items();
+    list.items_changed.connect((pos, removed, added) => {
+        n_items = n_items - removed + added;
+        assert_true(list.get_n_items() == n_items);
+        n_changes++;
+    });
+
+    // New items show up all at once, in the right place
+    collection.add(make_item("Cherry"));
+    assert_true(list.get_n_items() == 2);
+    flush_main_context();
+    assert_labels(list, { "banana", "Cherry", "date" });
+    assert_true(n_changes == 1);
+
+    // The same goes for removed items
+    collection.remove(list.get_item(0));
+    flush_main_context();
+    assert_labels(list, { "Cherry", "date" });
+    assert_true(n_changes == 2);
+
+    // Also when they end up in different places
+    collection.add(make_item("apple"));
+    collection.add(make_item("coconut"));
+    collection.add(make_item("elderberry"));
+    flush_main_context();
+    assert_labels(list, { "apple", "Cherry", "coconut", "date", "elderberry" });
+    assert_true(n_changes == 3);
+}
+
+private void test_item_list_remove() {
+    var collection = new Gcr.SimpleCollection();
+    var items = new GenericArray<Seahorse.Object>();
+    for (int i = 0; i < 100; i++) {
+        var item = make_item("item %03d".printf(i));
+        items.add(item);
+        collection.add(item);
+    }
+    var list = new Seahorse.ItemList(collection);
+
+    uint n_changes = 0;
+    list.items_changed.connect((pos, removed, added) => {
+        assert_true(added == 0);
+        n_changes++;
+    });
+
+    // Neighbouring items are removed together
+    for (int i = 10; i < 60; i++)
+        collection.remove(items[i]);
+    collection.remove(items[80]);
+    collection.remove(items[99]);
+    flush_main_context();
+    assert_true(list.get_n_items() == 48);
+    assert_true(n_changes == 3);
+    assert_true(((Seahorse.Object) list.get_item(10)).label == "item 060");
+
+    // A few are looked up on their own
+    n_changes = 0;
+    collection.remove(items[0]);
+    collection.remove(items[1]);
+    flush_main_context();
+    assert_true(list.get_n_items() == 46);
+    assert_true(n_changes == 2);
+
+    // Items that are added again before they're removed just stay
+    n_changes = 0;
+    collection.remove(items[2]);
+    collection.add(items[2]);
+    flush_main_context();
+    assert_true(list.get_n_items() == 46);
+    assert_true(n_changes == 0);
+}
+
+private void test_item_list_label_changed() {
+    var apple = make_item("apple");
+    var collection = new Gcr.SimpleCollection();
+    collection.add(apple);
+    collection.add(make_item("banana"));
+    collection.add(make_item("cherry"));
+    var list = new Seahorse.ItemList(collection);
+
+    uint n_changes = 0;
+    uint n_items = list.get_n_items();
+    list.items_changed.connect((pos, removed, added) => {
+        n_items = n_items - removed + added;
+        assert_true(list.get_n_items() == n_items);
+        n_changes++;
+    });
+
+    apple.label = "Elderberry";
+    assert_labels(list, { "banana", "cherry", "Elderberry" });
+    assert_true(n_changes == 2);
+
+    // Nothing moves, so nothing to report either
+    apple.label = "fig";
+    assert_labels(list, { "banana", "cherry", "fig" });
+    assert_true(n_changes == 2);
+}
+
+private void test_item_list_filter() {
+    var banana = make_item("banana");
+    var collection = new Gcr.SimpleCollection();
+    collection.add(make_item("apple"));
+    collection.add(make_item("apricot"));
+    collection.add(banana);
+    collection.add(make_item("cherry"));
+    var list = new Seahorse.ItemList(collection);
+
+    uint n_changes = 0;
+    list.items_changed.connect((pos, removed, added) => n_changes++);
+
+    // Only the items that don't match are removed
+    list.filter_text = "a";
+    list.refilter();
+    assert_labels(list, { "apple", "apricot", "banana" });
+    assert_true(n_changes == 1);
+
+    list.filter_text = "ap";
+    list.refilter();
+    assert_labels(list, { "apple", "apricot" });
+    assert_true(n_changes == 2);
+
+    // And only the ones that match again are added
+    list.filter_text = "";
+    assert_labels(list, { "apple", "apricot", "banana", "cherry" });
+    assert_true(n_changes == 3);
+
+    list.filter_text = "an";
+    list.refilter();
+    assert_labels(list, { "banana" });
+    list.filter_text = "r";
+    list.refilter();
+    assert_labels(list, { "apricot", "cherry" });
+
+    // A hidden item that changes to match shows up, also in a narrower
+    // search, but only once it's done changing
+    banana.label = "raspberry";
+    banana.nickname = "fruit";
+    list.filter_text = "rr";
+    list.refilter();
+    assert_labels(list, { "cherry" });
+    flush_main_context();
+    assert_labels(list, { "cherry", "raspberry" });
+}
+
+private void test_item_list_filter_delay() {
+    var collection = new Gcr.SimpleCollection();
+    collection.add(make_item("apple"));
+    collection.add(make_item("banana"));
+    var list = new Seahorse.ItemList(collection);
+
+    // Nothing happens while still typing
+    list.filter_text = "b";
+    list.filter_text = "ba";
+    assert_true(list.get_n_items() == 2);
+
+    while (list.get_n_items() != 1)
+        MainContext.default().iteration(true);
+    assert_labels(list, { "banana" });
+}
+
+private void test_item_list_filter_searchable() {
+    var alice = new TestKey("Alice <alice@example.org>", "0123456789ABCDEF");
+    var collection = new Gcr.SimpleCollection();
+    collection.add(alice);
+    collection.add(new TestKey("Bob", "FEDCBA9876543210"));
+    var list = new Seahorse.ItemList(collection);
+
+    // Search on the label, ignoring case
+    list.filter_text = "ALICE@";
+    list.refilter();
+    assert_labels(list, { "Alice <alice@example.org>" });
+
+    // Or on the extra text
+    list.filter_text = "abcdef";
+    list.refilter();
+    assert_labels(list, { "Alice <alice@example.org>" });
+
+    list.filter_text = "ba98";
+    list.refilter();
+    assert_labels(list, { "Bob" });
+
+    // Which is looked at again when the item changes
+    alice.keyid = "0000BA9800000000";
+    list.filter_text = "ba9";
+    list.refilter();
+    assert_labels(list, { "Alice <alice@example.org>", "Bob" });
+}
+
+private void test_item_list_filter_parallel() {
+    const int N_ITEMS = 20000;
+
+    var collection = new Gcr.SimpleCollection();
+    for (int i = 0; i < N_ITEMS; i++)
+        collection.add(make_item("item %05d".printf(i)));
+    var list = new Seahorse.ItemList(collection);
+
+    uint n_notifies = 0;
+    list.notify["refiltering"].connect(() => n_notifies++);
+
+    // A big list is filtered in the background
+    list.filter_text = "item 1";
+    list.refilter();
+    assert_true(list.refiltering);
+    assert_true(n_notifies == 1);
+    assert_true(list.get_n_items() == N_ITEMS);
+    wait_for_refilter(list);
+    assert_true(n_notifies == 2);
+    assert_true(list.get_n_items() == 10000);
+    assert_true(((Seahorse.Object) list.get_item(0)).label == "item 10000");
+
+    // Only the last search counts, even if the one before isn't done yet
+    list.filter_text = "item 15";
+    list.refilter();
+    list.filter_text = "item 0";
+    list.refilter();
+    wait_for_refilter(list);
+    assert_true(list.get_n_items() == 10000);
+    assert_true(((Seahorse.Object) list.get_item(0)).label == "item 00000");
+    assert_true(((Seahorse.Object) list.get_item(9999)).label == "item 09999");
+
+    // Items that change in the meantime are looked at again
+    list.filter_text = "item 000";
+    list.refilter();
+    var renamed = (Seahorse.Object) list.get_item(500);
+    renamed.label = "item 00099b";
+    wait_for_refilter(list);
+    assert_true(list.get_n_items() == 101);
+    assert_true(((Seahorse.Object) list.get_item(100)).label == "item 00099b");
+}
+
+private void assert_query(Seahorse.ItemList list, string query, string[] expected) {
+    list.filter_text = query;
+    list.refilter();
+    assert_labels(list, expected);
+}
+
+private void test_item_list_query() {
+    var alice = new TestKey("Alice", "0123456789ABCDEF");
+    alice.email = "alice@example.org";
+    alice.trust = (uint) Seahorse.Validity.FULL;
+    alice.expires = new DateTime.local(2024, 6, 1, 12, 0, 0);
+    var bob = new TestKey("Bob", "FEDCBA9876543210");
+    bob.email = "bob@example.com";
+    bob.trust = (uint) Seahorse.Validity.MARGINAL;
+
+    var collection = new Gcr.SimpleCollection();
+    collection.add(alice);
+    collection.add(bob);
+    collection.add(make_item("Carol"));
+    var list = new Seahorse.ItemList(collection);
+
+    assert_query(list, "email:example.org", { "Alice" });
+    assert_query(list, "keyid:89ABCDEF", { "Alice" });
+    assert_query(list, "keyid:0xFEDCBA9876543210", { "Bob" });
+    assert_query(list, "trust:full", { "Alice" });
+    assert_query(list, "trust>=marginal", { "Alice", "Bob" });
+    assert_query(list, "expires<2025-01-01", { "Alice" });
+    assert_query(list, "expires:2024-06-01", { "Alice" });
+    assert_query(list, "expires:never", { "Bob" });
+    assert_query(list, "type:pgp -email:example.org", { "Bob" });
+    assert_query(list, "email:example.org OR keyid:fedcba98", { "Alice", "Bob" });
+    assert_query(list, "NOT (trust:full OR trust:marginal)", { "Carol" });
+    assert_query(list, "b keyid:76543210", { "Bob" });
+
+    // Anything that isn't a query is searched for like always
+    assert_query(list, "Carol", { "Carol" });
+    list.filter_text = "expires<someday";
+    list.refilter();
+    assert_true(list.get_n_items() == 0);
+
+    // The index keeps up with changes
+    bob.keyid = "1111222233334444";
+    assert_query(list, "keyid:33334444", { "Bob" });
+    collection.remove(bob);
+    flush_main_context();
+    list.filter_text = "keyid:33334444";
+    list.refilter();
+    assert_true(list.get_n_items() == 0);
+}
+
+private void test_item_list_perf_sort() {
+    const int N_ITEMS = 100000;
+
+    var rand = new Rand.with_seed(42);
+    var collection = new Gcr.SimpleCollection();
+    for (int i = 0; i < N_ITEMS; i++) {
+        var label = "%s Key %08x".printf((rand.int_range(0, 2) == 0)? "My" : "my", rand.next_int());
+        collection.add(make_item(label));
+    }
+
+    Test.timer_start();
+    var list = new Seahorse.ItemList(collection);
+    var elapsed = Test.timer_elapsed();
+
+    assert_true(list.get_n_items() == N_ITEMS);
+    Test.minimized_result(elapsed, "Sorted %d items in %f seconds", N_ITEMS, elapsed);
+}
+
+private void test_item_list_perf_filter() {
+    const int N_ITEMS = 50000;
+    const string QUERY = "key a1";
+
+    var rand = new Rand.with_seed(42);
+    var collection = new Gcr.SimpleCollection();
+    for (int i = 0; i < N_ITEMS; i++)
+        collection.add(make_item("My Key %08x".printf(rand.next_int())));
+    var list = new Seahorse.ItemList(collection);
+
+    // Type the query one character at a time, and then clear it again
+    double slowest = 0;
+    for (int i = 1; i <= QUERY.length + 1; i++) {
+        Test.timer_start();
+        if (i <= QUERY.length)
+            list.filter_text = QUERY.substring(0, i);
+        else
+            list.filter_text = "";
+        list.refilter();
+        wait_for_refilter(list);
+        slowest = double.max(slowest, Test.timer_elapsed());
+    }
+
+    assert_true(list.get_n_items() == N_ITEMS);
+    Test.minimized_result(slowest, "Filtered %d items in at most %f seconds", N_ITEMS, slowest);
+}
@@ -0,0 +1,113 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+void main(string[] args) {
+    Test.init(ref args);
+
+    Test.add_func("/key-index/find", test_key_index_find);
+    Test.add_func("/key-index/changes", test_key_index_changes);
+
+    Test.run();
+}
+
+private class TestKey : Seahorse.Object, Seahorse.Searchable {
+    public string keyid { get; set; default = ""; }
+    public string fingerprint { get; set; default = ""; }
+
+    public TestKey(string label, string fingerprint) {
+        GLib.Object(label: label, fingerprint: fingerprint,
+                                keyid: fingerprint.substring(fingerprint.length - 16));
+    }
+
+    public string get_search_text() {
+        return "";
+    }
+
+    [CCode (array_length = false, array_null_terminated = true)]
+    public string[]? get_search_field(string field) {
+        switch (field) {
+            case "keyid":
+                return { this.keyid };
+            case "fpr":
+                return { this.fingerprint };
+            default:
+                return null;
+        }
+    }
+}
+
+private const string ALICE_FPR = "0123456789ABCDEF0123456789ABCDEF01234567";
+private const string BOB_FPR = "FEDCBA9876543210FEDCBA9876543210FEDCBA98";
+
+private void test_key_index_find() {
+    var alice = new TestKey("Alice", ALICE_FPR);
+    var bob = new TestKey("Bob", BOB_FPR);
+
+    // A backend, with a place that has the keys
+    var place = new Gcr.SimpleCollection();
+    place.add(alice);
+    place.add(bob);
+    var backend = new Gcr.SimpleCollection();
+    backend.add(place);
+
+    var index = new Seahorse.KeyIndex();
+    index.add_collection(backend);
+
+    var found = index.find_fingerprint("0123 4567 89AB CDEF 0123  4567 89AB CDEF 0123 4567");
+    assert_true(found.length == 1 && found[0] == alice);
+
+    found = index.find_keyid("0x89abcdef01234567");
+    assert_true(found.length == 1 && found[0] == alice);
+    found = index.find_keyid("DCBA98");
+    assert_true(found.length == 0);
+    found = index.find_keyid("10FEDCBA98");
+    assert_true(found.length == 0);
+    found = index.find("FEDCBA98");
+    assert_true(found.length == 1 && found[0] == bob);
+    found = index.find(BOB_FPR);
+    assert_true(found.length == 1 && found[0] == bob);
+}
+
+private void test_key_index_changes() {
+    var alice = new TestKey("Alice", ALICE_FPR);
+    var place = new Gcr.SimpleCollection();
+    var backend = new Gcr.SimpleCollection();
+    backend.add(place);
+
+    var index = new Seahorse.KeyIndex();
+    index.add_collection(backend);
+
+    // Keys that are added later are found too
+    place.add(alice);
+    assert_true(index.find_keyid("01234567").length == 1);
+
+    // And by their new ID once it changes
+    alice.keyid = "1111222233334444";
+    assert_true(index.find_keyid("01234567").length == 0);
+    assert_true(index.find_keyid("33334444").length == 1);
+
+    place.remove(alice);
+    assert_true(index.find_keyid("33334444").length == 0);
+
+    // Which also goes for places that are removed
+    place.add(alice);
+    assert_true(index.find(ALICE_FPR).length == 1);
+    backend.remove(place);
+    assert_true(index.find(ALICE_FPR).length == 0);
+}
@@ -0,0 +1,300 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "seahorse-discovery-cache.h"
+
+#include <glib/gstdio.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* The file is a keyfile with a group per key server:
+ *
+ *   [hkps://keys.openpgp.org]
+ *   0123456789ABCDEF=found:1700000000
+ *   FEDCBA9876543210=missing:1700000000
+ *
+ *   [hkp://%5B2001:db8::1%5D:11371]
+ *   ...
+ */
+#define FOUND_PREFIX   "found:"
+#define MISSING_PREFIX "missing:"
+
+struct _SeahorseDiscoveryCache {
+    GObject parent_instance;
+
+    char *filename;
+    GKeyFile *keyfile;
+    GTimeSpan found_ttl;
+    GTimeSpan missing_ttl;
+    gboolean dirty;
+};
+
+G_DEFINE_TYPE (SeahorseDiscoveryCache, seahorse_discovery_cache, G_TYPE_OBJECT);
+
+/* Key files don't allow brackets in group names (eg. of an IPv6 address),
+ * so those are escaped */
+static char *
+make_group (const char *uri)
+{
+    g_autofree char *down = g_ascii_strdown (uri, -1);
+
+    return g_uri_escape_string (down, ":/@", FALSE);
+}
+
+/* Fingerprints and key ids of the same key share the same entry */
+static char *
+make_key (const char *keyid)
+{
+    size_t len = strlen (keyid);
+
+    if (len > 16)
+        keyid += len - 16;
+    return g_ascii_strup (keyid, -1);
+}
+
+static SeahorseDiscoveryState
+parse_value (SeahorseDiscoveryCache *self,
+             const char             *value,
+             gint64                  now)
+{
+    SeahorseDiscoveryState state;
+    GTimeSpan ttl;
+    gint64 stamp;
+    char *end;
+
+    if (g_str_has_prefix (value, FOUND_PREFIX)) {
+        state = SEAHORSE_DISCOVERY_FOUND;
+        ttl = self->found_ttl;
+        value += strlen (FOUND_PREFIX);
+    } else if (g_str_has_prefix (value, MISSING_PREFIX)) {
+        state = SEAHORSE_DISCOVERY_MISSING;
+        ttl = self->missing_ttl;
+        value += strlen (MISSING_PREFIX);
+    } else {
+        return SEAHORSE_DISCOVERY_UNKNOWN;
+    }
+
+    stamp = g_ascii_strtoll (value, &end, 10);
+    if (end == value || *end != '\0')
+        return SEAHORSE_DISCOVERY_UNKNOWN;
+
+    /* Also distrust entries from the future (eg. a clock that was wrong) */
+    if (stamp > now || (now - stamp) * G_USEC_PER_SEC >= ttl)
+        return SEAHORSE_DISCOVERY_UNKNOWN;
+
+    return state;
+}
+
+static gint64
+get_now (void)
+{
+    return g_get_real_time () / G_USEC_PER_SEC;
+}
+
+static void
+seahorse_discovery_cache_init (SeahorseDiscoveryCache *self)
+{
+    self->keyfile = g_key_file_new ();
+}
+
+static void
+seahorse_discovery_cache_finalize (GObject *obj)
+{
+    SeahorseDiscoveryCache *self = SEAHORSE_DISCOVERY_CACHE (obj);
+
+    g_free (self->filename);
+    g_key_file_unref (self->keyfile);
+
+    G_OBJECT_CLASS (seahorse_discovery_cache_parent_class)->finalize (obj);
+}
+
+static void
+seahorse_discovery_cache_class_init (SeahorseDiscoveryCacheClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->finalize = seahorse_discovery_cache_finalize;
+}
+
+/**
+ * seahorse_discovery_cache_new:
+ * @filename: (nullable): The file to persist the cache in, or %NULL to only
+ *   keep it in memory
+ * @found_ttl: How long to remember keys that were found
+ * @missing_ttl: How long to remember keys that were missing
+ *
+ * Creates a discovery cache, loading the earlier entries from @filename.
+ *
+ * Returns: (transfer full): A new discovery cache
+ */
+SeahorseDiscoveryCache *
+seahorse_discovery_cache_new (const char *filename,
+                              GTimeSpan   found_ttl,
+                              GTimeSpan   missing_ttl)
+{
+    SeahorseDiscoveryCache *self;
+    g_autoptr(GError) error = NULL;
+
+    self = g_object_new (SEAHORSE_TYPE_DISCOVERY_CACHE, NULL);
+    self->filename = g_strdup (filename);
+    self->found_ttl = found_ttl;
+    self->missing_ttl = missing_ttl;
+
+    if (filename != NULL &&
+        !g_key_file_load_from_file (self->keyfile, filename, G_KEY_FILE_NONE, &error)) {
+        if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            g_message ("Couldn't load discovery cache '%s': %s", filename, error->message);
+    }
+
+    return self;
+}
+
+/**
+ * seahorse_discovery_cache_lookup:
+ * @self: A #SeahorseDiscoveryCache
+ * @uri: The URI of the key server
+ * @keyid: The key id or fingerprint of the key
+ *
+ * Returns: What we remember of @keyid on @uri, or
+ *   %SEAHORSE_DISCOVERY_UNKNOWN if it needs to be asked again
+ */
+SeahorseDiscoveryState
+seahorse_discovery_cache_lookup (SeahorseDiscoveryCache *self,
+                                 const char             *uri,
+                                 const char             *keyid)
+{
+    g_autofree char *group = NULL;
+    g_autofree char *key = NULL;
+    g_autofree char *value = NULL;
+
+    g_return_val_if_fail (SEAHORSE_IS_DISCOVERY_CACHE (self), SEAHORSE_DISCOVERY_UNKNOWN);
+    g_return_val_if_fail (uri != NULL, SEAHORSE_DISCOVERY_UNKNOWN);
+    g_return_val_if_fail (keyid != NULL, SEAHORSE_DISCOVERY_UNKNOWN);
+
+    group = make_group (uri);
+    key = make_key (keyid);
+    value = g_key_file_get_value (self->keyfile, group, key, NULL);
+    if (value == NULL)
+        return SEAHORSE_DISCOVERY_UNKNOWN;
+
+    return parse_value (self, value, get_now ());
+}
+
+/**
+ * seahorse_discovery_cache_record:
+ * @self: A #SeahorseDiscoveryCache
+ * @uri: The URI of the key server
+ * @keyid: The key id or fingerprint of the key
+ * @found: Whether the key server had the key
+ *
+ * Remembers the outcome of asking @uri for @keyid. Call
+ * seahorse_discovery_cache_save() to persist it.
+ */
+void
+seahorse_discovery_cache_record (SeahorseDiscoveryCache *self,
+                                 const char             *uri,
+                                 const char             *keyid,
+                                 gboolean                found)
+{
+    g_autofree char *group = NULL;
+    g_autofree char *key = NULL;
+    g_autofree char *value = NULL;
+
+    g_return_if_fail (SEAHORSE_IS_DISCOVERY_CACHE (self));
+    g_return_if_fail (uri != NULL);
+    g_return_if_fail (keyid != NULL);
+
+    group = make_group (uri);
+    key = make_key (keyid);
+    value = g_strdup_printf ("%s%" G_GINT64_FORMAT,
+                             found ? FOUND_PREFIX : MISSING_PREFIX, get_now ());
+    g_key_file_set_value (self->keyfile, group, key, value);
+    self->dirty = TRUE;
+}
+
+/* Drops the expired entries, so the file doesn't keep on growing */
+static void
+prune_expired (SeahorseDiscoveryCache *self)
+{
+    g_auto(GStrv) groups = NULL;
+    gint64 now = get_now ();
+
+    groups = g_key_file_get_groups (self->keyfile, NULL);
+    for (guint i = 0; groups[i] != NULL; i++) {
+        g_auto(GStrv) keys = NULL;
+        gsize n_keys, n_removed = 0;
+
+        keys = g_key_file_get_keys (self->keyfile, groups[i], &n_keys, NULL);
+        for (guint j = 0; keys && keys[j] != NULL; j++) {
+            g_autofree char *value = NULL;
+
+            value = g_key_file_get_value (self->keyfile, groups[i], keys[j], NULL);
+            if (value && parse_value (self, value, now) != SEAHORSE_DISCOVERY_UNKNOWN)
+                continue;
+
+            g_key_file_remove_key (self->keyfile, groups[i], keys[j], NULL);
+            n_removed++;
+        }
+
+        if (n_removed == n_keys)
+            g_key_file_remove_group (self->keyfile, groups[i], NULL);
+    }
+}
+
+/**
+ * seahorse_discovery_cache_save:
+ * @self: A #SeahorseDiscoveryCache
+ * @error: Error location
+ *
+ * Writes the cache to disk, if anything changed since it was loaded.
+ *
+ * Returns: Whether saving succeeded
+ */
+gboolean
+seahorse_discovery_cache_save (SeahorseDiscoveryCache *self,
+                               GError                **error)
+{
+    g_autofree char *dirname = NULL;
+
+    g_return_val_if_fail (SEAHORSE_IS_DISCOVERY_CACHE (self), FALSE);
+    g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+    if (self->filename == NULL || !self->dirty)
+        return TRUE;
+
+    prune_expired (self);
+
+    dirname = g_path_get_dirname (self->filename);
+    if (g_mkdir_with_parents (dirname, 0700) < 0) {
+        int errsv = errno;
+        g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                     "Couldn't create directory '%s': %s",
+                     dirname, g_strerror (errsv));
+        return FALSE;
+    }
+
+    if (!g_key_file_save_to_file (self->keyfile, self->filename, error))
+        return FALSE;
+
+    self->dirty = FALSE;
+    return TRUE;
+}
@@ -0,0 +1,58 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SeahorseDiscoveryCache: Remembers which key servers had which keys
+ *
+ * - Records whether a key id was found or missing on a key server, and when.
+ * - Persisted to disk, so signature browsing doesn't hit the network
+ *   again in every session.
+ * - Both kinds of entries expire, missing keys sooner than found ones.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+typedef enum {
+    SEAHORSE_DISCOVERY_UNKNOWN,
+    SEAHORSE_DISCOVERY_FOUND,
+    SEAHORSE_DISCOVERY_MISSING,
+} SeahorseDiscoveryState;
+
+#define SEAHORSE_TYPE_DISCOVERY_CACHE (seahorse_discovery_cache_get_type ())
+G_DECLARE_FINAL_TYPE (SeahorseDiscoveryCache, seahorse_discovery_cache,
+                      SEAHORSE, DISCOVERY_CACHE,
+                      GObject)
+
+SeahorseDiscoveryCache * seahorse_discovery_cache_new    (const char *filename,
+                                                          GTimeSpan   found_ttl,
+                                                          GTimeSpan   missing_ttl);
+
+SeahorseDiscoveryState   seahorse_discovery_cache_lookup (SeahorseDiscoveryCache *self,
+                                                          const char             *uri,
+                                                          const char             *keyid);
+
+void                     seahorse_discovery_cache_record (SeahorseDiscoveryCache *self,
+                                                          const char             *uri,
+                                                          const char             *keyid,
+                                                          gboolean                found);
+
+gboolean                 seahorse_discovery_cache_save   (SeahorseDiscoveryCache *self,
+                                                          GError                **error);
@@ -51,12 +51,37 @@
 #define PGP_KEY_BEGIN   "-----BEGIN PGP PUBLIC KEY BLOCK-----"
 #define PGP_KEY_END     "-----END PGP PUBLIC KEY BLOCK-----"
 
+/* Amount of keys that are sent to the server at the same time */
+#define HKP_MAX_UPLOADS 4
+
 G_DEFINE_QUARK (seahorse-hkp-error, seahorse_hkp_error);
 
 struct _SeahorseHKPSource {
     SeahorseServerSource parent;
+
+    GcrCollection *known_keys;
+    GHashTable *known_keyids;   /* key id → amount of known keys with it */
+    GHashTable *validators;     /* key id → HkpValidator */
 };
 
+/* What we know of the last copy of a key the server sent us, so we can ask
+ * it only to send the key again if it changed */
+typedef struct {
+    char *etag;
+    char *last_modified;
+    char *digest;
+} HkpValidator;
+
+static void
+hkp_validator_free (void *data)
+{
+    HkpValidator *validator = data;
+    g_free (validator->etag);
+    g_free (validator->last_modified);
+    g_free (validator->digest);
+    g_free (validator);
+}
+
 G_DEFINE_TYPE (SeahorseHKPSource, seahorse_hkp_source, SEAHORSE_TYPE_SERVER_SOURCE);
 
 /* Helper method */
@@ -112,7 +137,9 @@ create_hkp_soup_session (void)
     const char *env;
 #endif
 
-    session = soup_session_new ();
+    /* Allow the uploads to run side by side over kept-alive connections */
+    session = soup_session_new_with_options ("max-conns-per-host", HKP_MAX_UPLOADS,
+                                             NULL);
 
 #ifdef WITH_DEBUG
     env = g_getenv ("G_MESSAGES_DEBUG");
@@ -440,7 +467,7 @@ get_send_result (const char *response)
  * @text: The ASCII armoured key
  * @len: Length of the ASCII block or -1
  * @start: Returned, start of the key
- * @end: Returned, end of the key
+ * @end: Returned, just past the end of the key
  *
  * Finds a key in a char* block
  *
@@ -461,7 +488,7 @@ detect_key (const char *text, int len, const char **start, const char **end)
     if ((t = g_strstr_len (t, len - (t - text), PGP_KEY_END)) == NULL)
         return FALSE;
     if (end)
-        *end = t;
+        *end = t + strlen (PGP_KEY_END);
 
     return TRUE;
 }
@@ -619,8 +646,12 @@ typedef struct {
     SeahorseHKPSource *source;
     GInputStream *input;
     SoupSession *session;
-    SoupMessage *message;
-    int requests;
+    GUri *uri;
+    unsigned int in_flight;
+    unsigned int n_sent;
+    gboolean input_done;
+    GError *error;
+    GPtrArray *failures;
 } ImportClosure;
 
 static void
@@ -629,46 +660,156 @@ source_import_free (void *data)
     ImportClosure *closure = data;
     g_object_unref (closure->source);
     g_object_unref (closure->input);
-    g_object_unref (closure->message);
     g_object_unref (closure->session);
+    g_clear_pointer (&closure->uri, g_uri_unref);
+    g_clear_error (&closure->error);
+    g_ptr_array_unref (closure->failures);
     g_free (closure);
 }
 
+/* A single key that is being sent to the server */
+typedef struct {
+    GTask *task;
+    SoupMessage *message;
+    char *fingerprint;
+} ImportRequest;
+
+static void
+import_request_free (ImportRequest *request)
+{
+    g_object_unref (request->task);
+    g_object_unref (request->message);
+    g_free (request->fingerprint);
+    g_free (request);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (ImportRequest, import_request_free);
+
+static void import_send_keys (GTask *task);
+
 static void
 on_import_message_complete (GObject *object,
                             GAsyncResult *result,
                             void *user_data)
 {
     SoupSession *session = SOUP_SESSION (object);
-    g_autoptr(GTask) task = G_TASK (user_data);
-    ImportClosure *closure = g_task_get_task_data (task);
-    GCancellable *cancellable = g_task_get_cancellable (task);
+    g_autoptr(ImportRequest) request = user_data;
+    ImportClosure *closure = g_task_get_task_data (request->task);
+    GCancellable *cancellable = g_task_get_cancellable (request->task);
     g_autoptr(GBytes) response = NULL;
     g_autoptr(GString) response_str = NULL;
     g_autoptr(GError) error = NULL;
     g_autofree char *errmsg = NULL;
+    unsigned int status;
 
-    g_assert (closure->requests > 0);
-    seahorse_progress_end (cancellable, GUINT_TO_POINTER (closure->requests));
-    closure->requests--;
+    g_assert (closure->in_flight > 0);
+    closure->in_flight--;
+    seahorse_progress_end (cancellable, request);
 
     response = soup_session_send_and_read_finish (session, result, &error);
     if (!response) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return;
+        /* Stop sending more keys, but let the others finish */
+        if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            closure->input_done = TRUE;
+            if (closure->error == NULL)
+                closure->error = g_steal_pointer (&error);
+        } else {
+            errmsg = g_strdup (error->message);
+        }
+    } else {
+        status = soup_message_get_status (request->message);
+        response_str = g_string_new_len (g_bytes_get_data (response, NULL),
+                                         g_bytes_get_size (response));
+        errmsg = get_send_result (response_str->str);
+        if (errmsg == NULL && !SOUP_STATUS_IS_SUCCESSFUL (status))
+            errmsg = g_strdup (soup_message_get_reason_phrase (request->message));
     }
 
-    response_str = g_string_new_len (g_bytes_get_data (response, NULL),
-                                     g_bytes_get_size (response));
-    if ((errmsg = get_send_result (response_str->str)) != NULL) {
-        g_task_return_new_error (task, HKP_ERROR_DOMAIN,
-                                 soup_message_get_status (closure->message),
-                                 "%s", errmsg);
-        return;
+    if (errmsg != NULL) {
+        g_message ("Couldn't send key %s: %s", request->fingerprint, errmsg);
+        g_ptr_array_add (closure->failures,
+                         g_strdup_printf ("%s: %s", request->fingerprint, errmsg));
+    } else if (response != NULL) {
+        g_debug ("Sent key %s to HKP server", request->fingerprint);
+    }
+
+    import_send_keys (request->task);
+}
+
+/* Keeps up to HKP_MAX_UPLOADS keys in flight, and completes the task
+ * once the input is exhausted and every request came back */
+static void
+import_send_keys (GTask *task)
+{
+    ImportClosure *closure = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
+
+    while (!closure->input_done && closure->in_flight < HKP_MAX_UPLOADS) {
+        g_autoptr(GString) buf = g_string_sized_new (2048);
+        ImportRequest *request;
+        char *form;
+        g_autoptr(GBytes) bytes = NULL;
+        guint len;
+
+        if (g_cancellable_is_cancelled (cancellable)) {
+            if (closure->error == NULL)
+                g_cancellable_set_error_if_cancelled (cancellable, &closure->error);
+            closure->input_done = TRUE;
+            break;
+        }
+
+        /* Only read the next key block once there's room to send it */
+        len = seahorse_util_read_data_block (buf, closure->input,
+                                             PGP_KEY_BEGIN, PGP_KEY_END);
+        if (len <= 0) {
+            closure->input_done = TRUE;
+            break;
+        }
+
+        request = g_new0 (ImportRequest, 1);
+        request->task = g_object_ref (task);
+        request->fingerprint = seahorse_server_source_calc_armor_fingerprint (buf->str);
+        if (request->fingerprint == NULL)
+            request->fingerprint = g_strdup_printf ("#%u", closure->n_sent + 1);
+        request->message = soup_message_new_from_uri ("POST", closure->uri);
+
+        form = soup_form_encode ("keytext", buf->str, NULL);
+        bytes = g_bytes_new_take (form, strlen (form));
+        soup_message_set_request_body_from_bytes (request->message,
+                                                  "application/x-www-form-urlencoded",
+                                                  bytes);
+
+        closure->in_flight++;
+        closure->n_sent++;
+        seahorse_progress_prep_and_begin (cancellable, request,
+                                          _("Sending key %s"), request->fingerprint);
+
+        soup_session_send_and_read_async (closure->session,
+                                          request->message,
+                                          G_PRIORITY_DEFAULT,
+                                          cancellable,
+                                          on_import_message_complete,
+                                          request);
     }
 
-    /* A successful status from the server is all we want in this case */
-    if (closure->requests == 0) {
+    if (closure->in_flight > 0 || !closure->input_done)
+        return;
+
+    if (closure->error != NULL) {
+        g_task_return_error (task, g_steal_pointer (&closure->error));
+    } else if (closure->failures->len > 0) {
+        guint n_failed = closure->failures->len;
+        g_autofree char *details = NULL;
+
+        g_ptr_array_add (closure->failures, NULL);
+        details = g_strjoinv ("\n", (char **) closure->failures->pdata);
+        g_task_return_new_error (task, HKP_ERROR_DOMAIN, 0,
+                                 ngettext ("Couldn’t send %u key out of %u:\n%s",
+                                           "Couldn’t send %u keys out of %u:\n%s",
+                                           n_failed),
+                                 n_failed, closure->n_sent,
+                                 details);
+    } else {
         /* We don't know which keys got imported, so just return NULL */
         g_task_return_pointer (task, NULL, NULL);
     }
@@ -684,67 +825,25 @@ seahorse_hkp_source_import_async (SeahorseServerSource *source,
     SeahorseHKPSource *self = SEAHORSE_HKP_SOURCE (source);
     g_autoptr(GTask) task = NULL;
     ImportClosure *closure;
-    g_autoptr(GPtrArray) keydata = NULL;
-    g_autoptr(GUri) uri = NULL;
 
     task = g_task_new (source, cancellable, callback, user_data);
     closure = g_new0 (ImportClosure, 1);
     closure->input = g_object_ref (input);
     closure->source = g_object_ref (self);
     closure->session = create_hkp_soup_session ();
+    closure->failures = g_ptr_array_new_with_free_func (g_free);
     g_task_set_task_data (task, closure, source_import_free);
 
-    keydata = g_ptr_array_new_with_free_func (g_free);
-    for (;;) {
-        g_autoptr(GString) buf = g_string_sized_new (2048);
-        guint len;
-
-        len = seahorse_util_read_data_block (buf, input,
-                                             "-----BEGIN PGP PUBLIC KEY BLOCK-----",
-                                             "-----END PGP PUBLIC KEY BLOCK-----");
-        if (len <= 0)
-            break;
-
-        g_ptr_array_add (keydata, g_string_free (g_steal_pointer (&buf), FALSE));
-    }
-
-    if (keydata->len == 0) {
-        g_task_return_pointer (task, NULL, NULL);
-        return;
-    }
-
     /* Figure out the URI we're sending to */
-    uri = get_http_server_uri (self, "/pks/add", NULL);
-    g_return_if_fail (uri);
-
-    for (unsigned int i = 0; i < keydata->len; i++) {
-        const char *keytext = g_ptr_array_index (keydata, i);
-        g_autofree char *key = NULL;
-        g_autoptr(GBytes) bytes = NULL;
-
-        closure->message = soup_message_new_from_uri ("POST", uri);
-
-        key = soup_form_encode ("keytext", keytext, NULL);
-        bytes = g_bytes_new_static (key, strlen (key));
-        soup_message_set_request_body_from_bytes (closure->message,
-                                                  "application/x-www-form-urlencoded",
-                                                  bytes);
-
-        soup_session_send_and_read_async (closure->session,
-                                          closure->message,
-                                          G_PRIORITY_DEFAULT,
-                                          cancellable,
-                                          on_import_message_complete,
-                                          g_steal_pointer (&task));
-
-        closure->requests++;
-        seahorse_progress_prep_and_begin (cancellable, GUINT_TO_POINTER (closure->requests), NULL);
-    }
+    closure->uri = get_http_server_uri (self, "/pks/add", NULL);
+    g_return_if_fail (closure->uri);
 
     if (cancellable)
         g_cancellable_connect (cancellable,
                                G_CALLBACK (on_session_cancelled),
                                closure->session, NULL);
+
+    import_send_keys (task);
 }
 
 static GList *
@@ -763,8 +862,9 @@ typedef struct {
     GString *data;
     gsize data_len;
     SoupSession *session;
-    SoupMessage *message;
     int requests;
+    unsigned int unchanged;
+    GError *error;
 } ExportClosure;
 
 static void
@@ -774,54 +874,144 @@ export_closure_free (void *data)
     g_clear_object (&closure->source);
     if (closure->data)
         g_string_free (closure->data, TRUE);
-    g_clear_object (&closure->message);
     g_clear_object (&closure->session);
+    g_clear_error (&closure->error);
     g_free (closure);
 }
 
+typedef struct {
+    GTask *task;
+    char *keyid;
+    gboolean conditional;
+} ExportRequest;
+
+static void
+export_request_free (ExportRequest *request)
+{
+    g_object_unref (request->task);
+    g_free (request->keyid);
+    g_free (request);
+}
+
+/* Whether we already have a key with @keyid */
+static gboolean
+is_known_keyid (SeahorseHKPSource *self,
+                const char        *keyid)
+{
+    return self->known_keyids != NULL &&
+           g_hash_table_contains (self->known_keyids, keyid);
+}
+
+/* Remembers what the server sent for @request. Returns whether it's the same
+ * as what it sent the last time, when that's what we asked for. */
+static gboolean
+update_validator (SeahorseHKPSource *self,
+                  ExportRequest     *request,
+                  SoupMessage       *message,
+                  const char        *data,
+                  gsize              len)
+{
+    SoupMessageHeaders *headers;
+    HkpValidator *validator;
+    g_autofree char *digest = NULL;
+    gboolean unchanged;
+
+    if (soup_message_get_status (message) == SOUP_STATUS_NOT_MODIFIED)
+        return request->conditional;
+    if (!SOUP_STATUS_IS_SUCCESSFUL (soup_message_get_status (message)) || len == 0)
+        return FALSE;
+
+    if (self->validators == NULL)
+        self->validators = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                  g_free, hkp_validator_free);
+
+    /* Not every key server sends validators, but then we can still spare
+     * GnuPG from importing the same key again */
+    digest = seahorse_server_source_calc_armor_digest (data);
+    validator = g_hash_table_lookup (self->validators, request->keyid);
+    unchanged = request->conditional && validator != NULL && digest != NULL &&
+                g_strcmp0 (validator->digest, digest) == 0;
+
+    if (validator == NULL) {
+        validator = g_new0 (HkpValidator, 1);
+        g_hash_table_insert (self->validators, g_strdup (request->keyid), validator);
+    }
+
+    headers = soup_message_get_response_headers (message);
+    g_free (validator->etag);
+    validator->etag = g_strdup (soup_message_headers_get_one (headers, "ETag"));
+    g_free (validator->last_modified);
+    validator->last_modified = g_strdup (soup_message_headers_get_one (headers, "Last-Modified"));
+    g_free (validator->digest);
+    validator->digest = g_steal_pointer (&digest);
+
+    return unchanged;
+}
+
 static void
 on_export_message_complete (GObject *object,
                             GAsyncResult *result,
                             void *user_data)
 {
     SoupSession *session = SOUP_SESSION (object);
-    g_autoptr(GTask) task = G_TASK (user_data);
+    ExportRequest *request = user_data;
+    g_autoptr(GTask) task = g_object_ref (request->task);
     ExportClosure *closure = g_task_get_task_data (task);
     GCancellable *cancellable = g_task_get_cancellable (task);
+    SoupMessage *message;
     g_autoptr(GBytes) response = NULL;
+    g_autoptr(GString) keys = NULL;
     g_autoptr(GError) error = NULL;
     const char *start, *end, *text;
     size_t len;
 
-    seahorse_progress_end (cancellable, closure->message);
+    message = soup_session_get_async_result_message (session, result);
+    seahorse_progress_end (cancellable, message);
 
+    g_assert (closure->requests > 0);
+    closure->requests--;
+
+    /* Keep the first error, but wait for the other requests */
     response = soup_session_send_and_read_finish (session, result, &error);
     if (response == NULL) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return;
-    }
+        if (closure->error == NULL)
+            closure->error = g_steal_pointer (&error);
+    } else {
+        keys = g_string_new (NULL);
+        end = text = g_bytes_get_data (response, &len);
+        for (;;) {
+            len -= end - text;
+            text = end;
 
-    end = text = g_bytes_get_data (response, &len);
-    for (;;) {
-        len -= end - text;
-        text = end;
+            if (!detect_key (text, len, &start, &end))
+                break;
 
-        if (!detect_key (text, len, &start, &end))
-            break;
+            g_string_append_len (keys, start, end - start);
+            g_string_append_c (keys, '\n');
+        }
 
-        g_string_append_len (closure->data, start, end - start);
-        g_string_append_c (closure->data, '\n');
+        /* Unchanged keys don't need to be imported again */
+        if (update_validator (closure->source, request, message, keys->str, keys->len))
+            closure->unchanged++;
+        else
+            g_string_append_len (closure->data, keys->str, keys->len);
     }
 
-    g_assert (closure->requests > 0);
-    closure->requests--;
+    export_request_free (request);
 
-    if (closure->requests == 0) {
-        closure->data_len = closure->data->len;
-        g_task_return_pointer (task,
-                               g_string_free (g_steal_pointer (&closure->data), FALSE),
-                               g_free);
+    if (closure->requests > 0)
+        return;
+
+    if (closure->error != NULL) {
+        g_task_return_error (task, g_steal_pointer (&closure->error));
+        return;
     }
+
+    g_debug ("[hkp] skipped %u unchanged keys", closure->unchanged);
+    closure->data_len = closure->data->len;
+    g_task_return_pointer (task,
+                           g_string_free (g_steal_pointer (&closure->data), FALSE),
+                           g_free);
 }
 
 static void
@@ -847,13 +1037,15 @@ seahorse_hkp_source_export_async (SeahorseServerSource *source,
         return;
     }
 
-
     for (int i = 0; keyids[i] != NULL; i++) {
         const char *fpr = keyids[i];
         size_t len;
         g_autofree char *hexfpr = NULL;
         g_autoptr(GHashTable) form = NULL;
         g_autoptr(GUri) uri = NULL;
+        g_autoptr(SoupMessage) message = NULL;
+        ExportRequest *request;
+        HkpValidator *validator = NULL;
 
         form = g_hash_table_new (g_str_hash, g_str_equal);
 
@@ -872,17 +1064,35 @@ seahorse_hkp_source_export_async (SeahorseServerSource *source,
         uri = get_http_server_uri (self, "/pks/lookup", form);
         g_return_if_fail (uri);
 
-        closure->message = soup_message_new_from_uri ("GET", uri);
+        message = soup_message_new_from_uri ("GET", uri);
+
+        /* Every request holds on to the task until it completes */
+        request = g_new0 (ExportRequest, 1);
+        request->task = g_object_ref (task);
+        request->keyid = g_ascii_strup (fpr, -1);
+
+        /* Keys we already have are only sent again if they changed */
+        if (self->validators != NULL && is_known_keyid (self, request->keyid))
+            validator = g_hash_table_lookup (self->validators, request->keyid);
+        if (validator != NULL) {
+            SoupMessageHeaders *headers = soup_message_get_request_headers (message);
+
+            request->conditional = TRUE;
+            if (validator->etag)
+                soup_message_headers_replace (headers, "If-None-Match", validator->etag);
+            if (validator->last_modified)
+                soup_message_headers_replace (headers, "If-Modified-Since",
+                                              validator->last_modified);
+        }
 
+        closure->requests++;
+        seahorse_progress_prep_and_begin (cancellable, message, NULL);
         soup_session_send_and_read_async (closure->session,
-                                          closure->message,
+                                          message,
                                           G_PRIORITY_DEFAULT,
                                           cancellable,
                                           on_export_message_complete,
-                                          g_steal_pointer (&task));
-
-        closure->requests++;
-        seahorse_progress_prep_and_begin (cancellable, closure->message, NULL);
+                                          request);
     }
 
     if (cancellable)
@@ -912,11 +1122,25 @@ seahorse_hkp_source_init (SeahorseHKPSource *hsrc)
 {
 }
 
+static void
+seahorse_hkp_source_finalize (GObject *obj)
+{
+    SeahorseHKPSource *self = SEAHORSE_HKP_SOURCE (obj);
+
+    seahorse_hkp_source_set_known_keys (self, NULL);
+    g_clear_pointer (&self->validators, g_hash_table_unref);
+
+    G_OBJECT_CLASS (seahorse_hkp_source_parent_class)->finalize (obj);
+}
+
 static void
 seahorse_hkp_source_class_init (SeahorseHKPSourceClass *klass)
 {
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
     SeahorseServerSourceClass *server_class = SEAHORSE_SERVER_SOURCE_CLASS (klass);
 
+    gobject_class->finalize = seahorse_hkp_source_finalize;
+
     server_class->search_async = seahorse_hkp_source_search_async;
     server_class->search_finish = seahorse_hkp_source_search_finish;
     server_class->export_async = seahorse_hkp_source_export_async;
@@ -941,6 +1165,92 @@ seahorse_hkp_source_new (const char *uri)
     return g_object_new (SEAHORSE_TYPE_HKP_SOURCE, "uri", uri, NULL);
 }
 
+static void
+on_known_key_added (GcrCollection *collection,
+                    GObject       *object,
+                    void          *user_data)
+{
+    SeahorseHKPSource *self = SEAHORSE_HKP_SOURCE (user_data);
+    const char *keyid;
+    unsigned int count;
+
+    if (!SEAHORSE_PGP_IS_KEY (object))
+        return;
+    keyid = seahorse_pgp_key_get_keyid (SEAHORSE_PGP_KEY (object));
+    if (keyid == NULL)
+        return;
+
+    count = GPOINTER_TO_UINT (g_hash_table_lookup (self->known_keyids, keyid));
+    g_hash_table_replace (self->known_keyids, g_strdup (keyid),
+                          GUINT_TO_POINTER (count + 1));
+}
+
+static void
+on_known_key_removed (GcrCollection *collection,
+                      GObject       *object,
+                      void          *user_data)
+{
+    SeahorseHKPSource *self = SEAHORSE_HKP_SOURCE (user_data);
+    const char *keyid;
+    unsigned int count;
+
+    if (!SEAHORSE_PGP_IS_KEY (object))
+        return;
+    keyid = seahorse_pgp_key_get_keyid (SEAHORSE_PGP_KEY (object));
+    if (keyid == NULL)
+        return;
+
+    count = GPOINTER_TO_UINT (g_hash_table_lookup (self->known_keyids, keyid));
+    if (count > 1)
+        g_hash_table_replace (self->known_keyids, g_strdup (keyid),
+                              GUINT_TO_POINTER (count - 1));
+    else
+        g_hash_table_remove (self->known_keyids, keyid);
+}
+
+/**
+ * seahorse_hkp_source_set_known_keys:
+ * @self: An HKP source
+ * @keys: (nullable): The keys we already have, usually the local keyring
+ *
+ * Exporting keys from @self that are in @keys asks the key server to only
+ * send them if they changed since the last time. Keys that didn't change
+ * are left out of the exported data, so they aren't imported again.
+ */
+void
+seahorse_hkp_source_set_known_keys (SeahorseHKPSource *self,
+                                    GcrCollection     *keys)
+{
+    g_autoptr(GList) objects = NULL;
+
+    g_return_if_fail (SEAHORSE_IS_HKP_SOURCE (self));
+    g_return_if_fail (keys == NULL || GCR_IS_COLLECTION (keys));
+
+    if (self->known_keys == keys)
+        return;
+
+    if (self->known_keys != NULL) {
+        g_signal_handlers_disconnect_by_data (self->known_keys, self);
+        g_clear_object (&self->known_keys);
+        g_clear_pointer (&self->known_keyids, g_hash_table_unref);
+    }
+
+    if (keys == NULL)
+        return;
+
+    /* Kept up to date, so an export doesn't have to go through all of them */
+    self->known_keys = g_object_ref (keys);
+    self->known_keyids = g_hash_table_new_full (seahorse_pgp_keyid_hash,
+                                                seahorse_pgp_keyid_equal,
+                                                g_free, NULL);
+    g_signal_connect (keys, "added", G_CALLBACK (on_known_key_added), self);
+    g_signal_connect (keys, "removed", G_CALLBACK (on_known_key_removed), self);
+
+    objects = gcr_collection_get_objects (keys);
+    for (GList *l = objects; l != NULL; l = g_list_next (l))
+        on_known_key_added (keys, l->data, self);
+}
+
 /**
  * seahorse_hkp_is_valid_uri:
  * @uri: The uri to check
@@ -39,6 +39,9 @@ G_DECLARE_FINAL_TYPE (SeahorseHKPSource, seahorse_hkp_source,
 
 SeahorseHKPSource*    seahorse_hkp_source_new      (const char *uri);
 
+void                  seahorse_hkp_source_set_known_keys (SeahorseHKPSource *self,
+                                                          GcrCollection     *keys);
+
 gboolean              seahorse_hkp_is_valid_uri    (const char *uri);
 
 GList *               seahorse_hkp_parse_lookup_response  (const char *response);
@@ -0,0 +1,704 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "seahorse-keyserver-refresh.h"
+
+#include "seahorse-hkp-source.h"
+#include "seahorse-pgp-key.h"
+#include "seahorse-pgp-subkey.h"
+#include "seahorse-server-source.h"
+
+#include <gcr/gcr.h>
+#include <glib/gstdio.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* The file is a keyfile with the last refresh of every key, and a digest of
+ * what the key server returned for it then (empty if nothing came back):
+ *
+ *   [keys]
+ *   0123456789ABCDEF0123456789ABCDEF01234567=1700000000:9f86d0...
+ */
+#define STATE_GROUP "keys"
+
+#define PGP_KEY_BEGIN "-----BEGIN PGP PUBLIC KEY BLOCK-----"
+#define PGP_KEY_END   "-----END PGP PUBLIC KEY BLOCK-----"
+
+/* At most this many keys are asked for at once */
+#define BATCH_MAX_KEYS 4
+
+/* Bounds, in seconds, on the wait between two batches */
+#define MIN_DELAY 60
+#define MAX_DELAY (6 * 60 * 60)
+
+/* The default budget, per hour */
+#define DEFAULT_MAX_REQUESTS 30
+#define DEFAULT_MAX_BYTES    (2 * 1024 * 1024)
+
+struct _SeahorseKeyserverRefresh {
+    GObject parent_instance;
+
+    SeahorseGpgmeKeyring *keyring;
+    GListModel *remotes;
+
+    char *filename;
+    GKeyFile *keyfile;
+    gboolean dirty;
+
+    guint period;
+    guint timeout_id;
+    GCancellable *cancellable;
+    gboolean busy;
+
+    /* A token bucket for requests and one for bytes, refilled over an hour */
+    guint max_requests;
+    gsize max_bytes;
+    double request_tokens;
+    double byte_tokens;
+    gint64 budget_stamp;
+};
+
+G_DEFINE_TYPE (SeahorseKeyserverRefresh, seahorse_keyserver_refresh, G_TYPE_OBJECT);
+
+static void schedule_next (SeahorseKeyserverRefresh *self);
+
+static gint64
+get_now (void)
+{
+    return g_get_real_time () / G_USEC_PER_SEC;
+}
+
+static gboolean
+get_entry (SeahorseKeyserverRefresh *self,
+           const char               *fingerprint,
+           gint64                   *stamp,
+           char                    **digest)
+{
+    g_autofree char *value = NULL;
+    char *end;
+
+    value = g_key_file_get_value (self->keyfile, STATE_GROUP, fingerprint, NULL);
+    if (value == NULL)
+        return FALSE;
+
+    *stamp = g_ascii_strtoll (value, &end, 10);
+    if (end == value || *end != ':')
+        return FALSE;
+
+    if (digest != NULL)
+        *digest = end[1] ? g_strdup (end + 1) : NULL;
+    return TRUE;
+}
+
+static void
+set_entry (SeahorseKeyserverRefresh *self,
+           const char               *fingerprint,
+           gint64                    stamp,
+           const char               *digest)
+{
+    g_autofree char *value = NULL;
+
+    value = g_strdup_printf ("%" G_GINT64_FORMAT ":%s", stamp, digest ? digest : "");
+    g_key_file_set_value (self->keyfile, STATE_GROUP, fingerprint, value);
+    self->dirty = TRUE;
+}
+
+static void
+budget_refill (SeahorseKeyserverRefresh *self)
+{
+    gint64 now = g_get_monotonic_time ();
+    double hours;
+
+    hours = (double) (now - self->budget_stamp) / G_TIME_SPAN_HOUR;
+    self->budget_stamp = now;
+
+    self->request_tokens = MIN (self->max_requests,
+                                self->request_tokens + hours * self->max_requests);
+    self->byte_tokens = MIN (self->max_bytes,
+                             self->byte_tokens + hours * self->max_bytes);
+}
+
+static gboolean
+budget_allows (SeahorseKeyserverRefresh *self)
+{
+    budget_refill (self);
+    return self->request_tokens >= 1.0 && self->byte_tokens > 0.0;
+}
+
+static void
+seahorse_keyserver_refresh_init (SeahorseKeyserverRefresh *self)
+{
+    self->keyfile = g_key_file_new ();
+    self->max_requests = DEFAULT_MAX_REQUESTS;
+    self->max_bytes = DEFAULT_MAX_BYTES;
+    self->request_tokens = self->max_requests;
+    self->byte_tokens = self->max_bytes;
+    self->budget_stamp = g_get_monotonic_time ();
+}
+
+static void
+seahorse_keyserver_refresh_dispose (GObject *obj)
+{
+    SeahorseKeyserverRefresh *self = SEAHORSE_KEYSERVER_REFRESH (obj);
+
+    seahorse_keyserver_refresh_stop (self);
+
+    G_OBJECT_CLASS (seahorse_keyserver_refresh_parent_class)->dispose (obj);
+}
+
+static void
+seahorse_keyserver_refresh_finalize (GObject *obj)
+{
+    SeahorseKeyserverRefresh *self = SEAHORSE_KEYSERVER_REFRESH (obj);
+
+    g_clear_object (&self->keyring);
+    g_clear_object (&self->remotes);
+    g_free (self->filename);
+    g_key_file_unref (self->keyfile);
+
+    G_OBJECT_CLASS (seahorse_keyserver_refresh_parent_class)->finalize (obj);
+}
+
+static void
+seahorse_keyserver_refresh_class_init (SeahorseKeyserverRefreshClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->dispose = seahorse_keyserver_refresh_dispose;
+    gobject_class->finalize = seahorse_keyserver_refresh_finalize;
+}
+
+/**
+ * seahorse_keyserver_refresh_new:
+ * @keyring: The keyring with the keys to refresh
+ * @remotes: A #GListModel of #SeahorseServerSource to refresh from
+ * @filename: (nullable): The file to persist the state in, or %NULL to only
+ *   keep it in memory
+ *
+ * Creates a background refresh of the keys in @keyring. It doesn't do
+ * anything until seahorse_keyserver_refresh_start() is called.
+ *
+ * Returns: (transfer full): A new #SeahorseKeyserverRefresh
+ */
+SeahorseKeyserverRefresh *
+seahorse_keyserver_refresh_new (SeahorseGpgmeKeyring *keyring,
+                                GListModel           *remotes,
+                                const char           *filename)
+{
+    SeahorseKeyserverRefresh *self;
+    g_autoptr(GError) error = NULL;
+
+    g_return_val_if_fail (SEAHORSE_IS_GPGME_KEYRING (keyring), NULL);
+    g_return_val_if_fail (G_IS_LIST_MODEL (remotes), NULL);
+
+    self = g_object_new (SEAHORSE_TYPE_KEYSERVER_REFRESH, NULL);
+    self->keyring = g_object_ref (keyring);
+    self->remotes = g_object_ref (remotes);
+    self->filename = g_strdup (filename);
+
+    if (filename != NULL &&
+        !g_key_file_load_from_file (self->keyfile, filename, G_KEY_FILE_NONE, &error)) {
+        if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            g_message ("Couldn't load key refresh state '%s': %s", filename, error->message);
+    }
+
+    return self;
+}
+
+/**
+ * seahorse_keyserver_refresh_set_budget:
+ * @self: A #SeahorseKeyserverRefresh
+ * @max_requests: The number of requests allowed per hour
+ * @max_bytes: The number of bytes that may be downloaded per hour
+ *
+ * Limits how much the refresh may use the network. When the budget is spent,
+ * batches are postponed until it has been replenished.
+ */
+void
+seahorse_keyserver_refresh_set_budget (SeahorseKeyserverRefresh *self,
+                                       guint                     max_requests,
+                                       gsize                     max_bytes)
+{
+    g_return_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self));
+    g_return_if_fail (max_requests > 0 && max_bytes > 0);
+
+    budget_refill (self);
+    self->max_requests = max_requests;
+    self->max_bytes = max_bytes;
+    self->request_tokens = MIN (self->request_tokens, max_requests);
+    self->byte_tokens = MIN (self->byte_tokens, max_bytes);
+}
+
+/**
+ * seahorse_keyserver_refresh_filter_changed:
+ * @self: A #SeahorseKeyserverRefresh
+ * @data: The keys returned by a key server, ASCII armored
+ * @size: The length of @data
+ * @digests: (out) (optional) (transfer full): The digests of the changed
+ *   keys, by fingerprint
+ *
+ * Picks the key blocks from @data that differ from what was recorded for
+ * them with seahorse_keyserver_refresh_record(). Blocks of which the
+ * fingerprint can't be calculated are always considered changed.
+ *
+ * Returns: (transfer full) (nullable): The changed key blocks, or %NULL if
+ *   nothing changed
+ */
+GBytes *
+seahorse_keyserver_refresh_filter_changed (SeahorseKeyserverRefresh *self,
+                                           const char               *data,
+                                           gsize                     size,
+                                           GHashTable              **digests)
+{
+    g_autoptr(GHashTable) changed_digests = NULL;
+    g_autoptr(GByteArray) changed = NULL;
+    const char *pos = data;
+    const char *end = data + size;
+
+    g_return_val_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self), NULL);
+    g_return_val_if_fail (data != NULL || size == 0, NULL);
+
+    changed_digests = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    changed = g_byte_array_new ();
+
+    while (pos < end) {
+        g_autofree char *block = NULL;
+        g_autofree char *armor_fpr = NULL;
+        g_autofree char *digest = NULL;
+        const char *begin, *block_end;
+
+        begin = g_strstr_len (pos, end - pos, PGP_KEY_BEGIN);
+        if (begin == NULL)
+            break;
+        block_end = g_strstr_len (begin, end - begin, PGP_KEY_END);
+        if (block_end == NULL)
+            break;
+        block_end += strlen (PGP_KEY_END);
+        pos = block_end;
+
+        block = g_strndup (begin, block_end - begin);
+        armor_fpr = seahorse_server_source_calc_armor_fingerprint (block);
+        if (armor_fpr != NULL) {
+            g_autofree char *known = NULL;
+            gint64 stamp;
+
+            digest = seahorse_server_source_calc_armor_digest (block);
+            if (digest != NULL &&
+                get_entry (self, armor_fpr, &stamp, &known) &&
+                g_strcmp0 (known, digest) == 0)
+                continue;
+
+            g_hash_table_replace (changed_digests,
+                                  g_steal_pointer (&armor_fpr),
+                                  g_steal_pointer (&digest));
+        }
+
+        g_byte_array_append (changed, (const guint8 *) begin, block_end - begin);
+        g_byte_array_append (changed, (const guint8 *) "\n", 1);
+    }
+
+    if (digests != NULL)
+        *digests = g_steal_pointer (&changed_digests);
+    if (changed->len == 0)
+        return NULL;
+    return g_byte_array_free_to_bytes (g_steal_pointer (&changed));
+}
+
+/**
+ * seahorse_keyserver_refresh_record:
+ * @self: A #SeahorseKeyserverRefresh
+ * @fingerprints: (array zero-terminated=1): The keys that were refreshed
+ * @digests: (nullable): The new digests of keys, by fingerprint, as
+ *   returned by seahorse_keyserver_refresh_filter_changed()
+ *
+ * Remembers that @fingerprints were refreshed just now, and that the keys
+ * in @digests were imported. Call seahorse_keyserver_refresh_save() to
+ * persist it.
+ */
+void
+seahorse_keyserver_refresh_record (SeahorseKeyserverRefresh *self,
+                                   const char * const       *fingerprints,
+                                   GHashTable               *digests)
+{
+    GHashTableIter iter;
+    const char *fingerprint, *digest;
+    gint64 now = get_now ();
+
+    g_return_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self));
+    g_return_if_fail (fingerprints != NULL);
+
+    for (guint i = 0; fingerprints[i] != NULL; i++) {
+        g_autofree char *fpr = NULL;
+        g_autofree char *known = NULL;
+        gint64 stamp;
+
+        fpr = seahorse_pgp_subkey_normalize_fingerprint (fingerprints[i]);
+        get_entry (self, fpr, &stamp, &known);
+        set_entry (self, fpr, now, known);
+    }
+
+    if (digests == NULL)
+        return;
+
+    g_hash_table_iter_init (&iter, digests);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &fingerprint, (gpointer *) &digest))
+        set_entry (self, fingerprint, now, digest);
+}
+
+/* Drops the keys that aren't in the keyring anymore */
+static void
+prune_removed (SeahorseKeyserverRefresh *self)
+{
+    g_autoptr(GHashTable) present = NULL;
+    g_autolist(GObject) keys = NULL;
+    g_auto(GStrv) fingerprints = NULL;
+
+    present = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    keys = gcr_collection_get_objects (GCR_COLLECTION (self->keyring));
+    g_list_foreach (keys, (GFunc) g_object_ref, NULL);
+    for (GList *l = keys; l != NULL; l = g_list_next (l)) {
+        const char *fpr = seahorse_pgp_key_get_fingerprint (SEAHORSE_PGP_KEY (l->data));
+        g_hash_table_add (present, seahorse_pgp_subkey_normalize_fingerprint (fpr));
+    }
+
+    /* Don't drop everything while the keyring is still loading */
+    if (g_hash_table_size (present) == 0)
+        return;
+
+    fingerprints = g_key_file_get_keys (self->keyfile, STATE_GROUP, NULL, NULL);
+    for (guint i = 0; fingerprints && fingerprints[i] != NULL; i++) {
+        if (!g_hash_table_contains (present, fingerprints[i]))
+            g_key_file_remove_key (self->keyfile, STATE_GROUP, fingerprints[i], NULL);
+    }
+}
+
+/**
+ * seahorse_keyserver_refresh_save:
+ * @self: A #SeahorseKeyserverRefresh
+ * @error: Error location
+ *
+ * Writes the state to disk, if anything changed since it was loaded.
+ *
+ * Returns: Whether saving succeeded
+ */
+gboolean
+seahorse_keyserver_refresh_save (SeahorseKeyserverRefresh *self,
+                                 GError                  **error)
+{
+    g_autofree char *dirname = NULL;
+
+    g_return_val_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self), FALSE);
+    g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+    if (self->filename == NULL || !self->dirty)
+        return TRUE;
+
+    prune_removed (self);
+
+    dirname = g_path_get_dirname (self->filename);
+    if (g_mkdir_with_parents (dirname, 0700) < 0) {
+        int errsv = errno;
+        g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                     "Couldn't create directory '%s': %s",
+                     dirname, g_strerror (errsv));
+        return FALSE;
+    }
+
+    if (!g_key_file_save_to_file (self->keyfile, self->filename, error))
+        return FALSE;
+
+    self->dirty = FALSE;
+    return TRUE;
+}
+
+typedef struct {
+    SeahorseKeyserverRefresh *self;
+    GCancellable *cancellable;
+    GStrv fingerprints;
+    GHashTable *digests;
+} RefreshBatch;
+
+static void
+refresh_batch_free (RefreshBatch *batch)
+{
+    g_object_unref (batch->self);
+    g_object_unref (batch->cancellable);
+    g_strfreev (batch->fingerprints);
+    g_clear_pointer (&batch->digests, g_hash_table_unref);
+    g_free (batch);
+}
+
+static void
+refresh_batch_done (RefreshBatch *batch,
+                    GError       *error)
+{
+    SeahorseKeyserverRefresh *self = batch->self;
+    g_autoptr(GError) save_error = NULL;
+
+    /* Stopped: whoever restarts us schedules the next batch */
+    if (g_cancellable_is_cancelled (batch->cancellable)) {
+        refresh_batch_free (batch);
+        return;
+    }
+
+    if (error != NULL)
+        g_message ("Couldn't refresh keys from key server: %s", error->message);
+
+    /* Only remember the digests of what was imported, so failed keys are
+     * tried again the next time */
+    seahorse_keyserver_refresh_record (self,
+                                       (const char * const *) batch->fingerprints,
+                                       error ? NULL : batch->digests);
+    if (!seahorse_keyserver_refresh_save (self, &save_error))
+        g_message ("Couldn't save key refresh state: %s", save_error->message);
+
+    self->busy = FALSE;
+    schedule_next (self);
+
+    refresh_batch_free (batch);
+}
+
+static void
+on_refresh_import_completed (GObject      *object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+    RefreshBatch *batch = user_data;
+    g_autoptr(GError) error = NULL;
+    GList *imported;
+
+    imported = seahorse_gpgme_keyring_import_finish (SEAHORSE_GPGME_KEYRING (object),
+                                                     result, &error);
+    g_debug ("[refresh] imported %u changed keys", g_list_length (imported));
+    g_list_free (imported);
+
+    refresh_batch_done (batch, error);
+}
+
+static void
+on_refresh_export_completed (GObject      *object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+    RefreshBatch *batch = user_data;
+    SeahorseKeyserverRefresh *self = batch->self;
+    g_autoptr(GError) error = NULL;
+    g_autoptr(GBytes) changed = NULL;
+    g_autoptr(GInputStream) input = NULL;
+    g_autofree char *data = NULL;
+    gsize size = 0;
+
+    data = seahorse_server_source_export_finish (SEAHORSE_SERVER_SOURCE (object),
+                                                 result, &size, &error);
+    if (error != NULL) {
+        refresh_batch_done (batch, error);
+        return;
+    }
+
+    self->byte_tokens -= size;
+
+    changed = seahorse_keyserver_refresh_filter_changed (self, data, size,
+                                                         &batch->digests);
+    if (changed == NULL) {
+        g_debug ("[refresh] no changes in %u keys", g_strv_length (batch->fingerprints));
+        refresh_batch_done (batch, NULL);
+        return;
+    }
+
+    input = g_memory_input_stream_new_from_bytes (changed);
+    seahorse_gpgme_keyring_import_async (self->keyring, input, batch->cancellable,
+                                         on_refresh_import_completed, batch);
+}
+
+/* Picks up to @max_keys keys, preferring the ones that weren't refreshed
+ * for a while */
+static GStrv
+pick_batch (SeahorseKeyserverRefresh *self,
+            guint                     max_keys)
+{
+    g_autolist(GObject) keys = NULL;
+    g_autoptr(GPtrArray) candidates = NULL;
+    g_autoptr(GPtrArray) batch = NULL;
+    gint64 now = get_now ();
+    guint n_batch;
+
+    keys = gcr_collection_get_objects (GCR_COLLECTION (self->keyring));
+    g_list_foreach (keys, (GFunc) g_object_ref, NULL);
+
+    candidates = g_ptr_array_new_with_free_func (g_free);
+    for (GList *l = keys; l != NULL; l = g_list_next (l)) {
+        const char *fpr = seahorse_pgp_key_get_fingerprint (SEAHORSE_PGP_KEY (l->data));
+        g_autofree char *normalized = NULL;
+        gint64 stamp;
+
+        normalized = seahorse_pgp_subkey_normalize_fingerprint (fpr);
+        if (*normalized == '\0')
+            continue;
+        if (get_entry (self, normalized, &stamp, NULL) &&
+            stamp <= now && now - stamp < self->period / 2)
+            continue;
+
+        g_ptr_array_add (candidates, g_steal_pointer (&normalized));
+    }
+
+    /* A partial Fisher-Yates shuffle */
+    n_batch = MIN (candidates->len, (guint) g_random_int_range (1, max_keys + 1));
+    batch = g_ptr_array_new_full (n_batch + 1, g_free);
+    for (guint i = 0; i < n_batch; i++) {
+        guint j = g_random_int_range (i, candidates->len);
+        gpointer tmp = candidates->pdata[i];
+
+        candidates->pdata[i] = candidates->pdata[j];
+        candidates->pdata[j] = tmp;
+        g_ptr_array_add (batch, g_steal_pointer (&candidates->pdata[i]));
+    }
+    g_ptr_array_add (batch, NULL);
+
+    return (GStrv) g_ptr_array_free (g_steal_pointer (&batch), FALSE);
+}
+
+/* HKP servers are asked for every key on its own, LDAP servers for all of
+ * them in one search */
+static gboolean
+asks_per_key (SeahorseServerSource *remote)
+{
+#ifdef WITH_HKP
+    return SEAHORSE_IS_HKP_SOURCE (remote);
+#else
+    return FALSE;
+#endif
+}
+
+static gboolean
+on_timeout_refresh (gpointer user_data)
+{
+    SeahorseKeyserverRefresh *self = SEAHORSE_KEYSERVER_REFRESH (user_data);
+    g_autoptr(SeahorseServerSource) remote = NULL;
+    RefreshBatch *batch;
+    GStrv fingerprints;
+    guint n_remotes;
+    guint max_keys;
+    guint n_requests;
+
+    self->timeout_id = 0;
+
+    n_remotes = g_list_model_get_n_items (self->remotes);
+    if (n_remotes == 0 || !budget_allows (self)) {
+        schedule_next (self);
+        return G_SOURCE_REMOVE;
+    }
+
+    /* A different key server every time, so none of them sees all our keys */
+    remote = g_list_model_get_item (self->remotes, g_random_int_range (0, n_remotes));
+
+    /* Only as many keys as the budget has requests left for */
+    max_keys = BATCH_MAX_KEYS;
+    if (asks_per_key (remote))
+        max_keys = MIN (max_keys, (guint) self->request_tokens);
+
+    fingerprints = pick_batch (self, max_keys);
+    if (fingerprints[0] == NULL) {
+        g_strfreev (fingerprints);
+        schedule_next (self);
+        return G_SOURCE_REMOVE;
+    }
+
+    batch = g_new0 (RefreshBatch, 1);
+    batch->self = g_object_ref (self);
+    batch->cancellable = g_object_ref (self->cancellable);
+    batch->fingerprints = fingerprints;
+
+    n_requests = asks_per_key (remote) ? g_strv_length (fingerprints) : 1;
+    g_debug ("[refresh] refreshing %u keys", g_strv_length (fingerprints));
+    self->busy = TRUE;
+    self->request_tokens -= n_requests;
+    seahorse_server_source_export_async (remote, (const char **) fingerprints,
+                                         batch->cancellable,
+                                         on_refresh_export_completed, batch);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* Waits long enough that, on average, every key is refreshed once per
+ * period. The wait is random, so batches can't be told apart by timing. */
+static void
+schedule_next (SeahorseKeyserverRefresh *self)
+{
+    guint n_keys;
+    guint mean, delay;
+
+    g_return_if_fail (self->timeout_id == 0);
+
+    n_keys = MAX (gcr_collection_get_length (GCR_COLLECTION (self->keyring)), 1);
+    mean = (guint) ((guint64) self->period * (BATCH_MAX_KEYS + 1) / 2 / n_keys);
+    mean = CLAMP (mean, MIN_DELAY, MAX_DELAY);
+    delay = g_random_int_range (MIN_DELAY, 2 * mean + 1);
+
+    g_debug ("[refresh] next batch in %u seconds", delay);
+    self->timeout_id = g_timeout_add_seconds_full (G_PRIORITY_LOW, delay,
+                                                   on_timeout_refresh,
+                                                   self, NULL);
+}
+
+/**
+ * seahorse_keyserver_refresh_start:
+ * @self: A #SeahorseKeyserverRefresh
+ * @period: The number of seconds in which every key should be refreshed
+ *
+ * Starts refreshing keys in the background, or changes the period if it was
+ * already running.
+ */
+void
+seahorse_keyserver_refresh_start (SeahorseKeyserverRefresh *self,
+                                  guint                     period)
+{
+    g_return_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self));
+    g_return_if_fail (period > 0);
+
+    self->period = period;
+
+    if (self->cancellable == NULL)
+        self->cancellable = g_cancellable_new ();
+
+    g_clear_handle_id (&self->timeout_id, g_source_remove);
+    if (!self->busy)
+        schedule_next (self);
+}
+
+/**
+ * seahorse_keyserver_refresh_stop:
+ * @self: A #SeahorseKeyserverRefresh
+ *
+ * Stops refreshing keys, cancelling the batch that is underway.
+ */
+void
+seahorse_keyserver_refresh_stop (SeahorseKeyserverRefresh *self)
+{
+    g_return_if_fail (SEAHORSE_IS_KEYSERVER_REFRESH (self));
+
+    g_clear_handle_id (&self->timeout_id, g_source_remove);
+    if (self->cancellable != NULL) {
+        g_cancellable_cancel (self->cancellable);
+        g_clear_object (&self->cancellable);
+    }
+    self->busy = FALSE;
+}
@@ -0,0 +1,68 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SeahorseKeyserverRefresh: Refreshes the keyring from key servers in the
+ * background
+ *
+ * - Every key is refreshed about once per period, a few keys at a time, at
+ *   random moments and from a random key server, so no single server sees
+ *   the whole keyring. The keys of one batch do go to the same server
+ *   together, which can tell that those belong to the same user.
+ * - Stays within a budget of requests and bytes per hour.
+ * - Remembers a digest of what the servers returned, and only imports the
+ *   keys that changed since the last time.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include "seahorse-gpgme-keyring.h"
+
+#define SEAHORSE_TYPE_KEYSERVER_REFRESH (seahorse_keyserver_refresh_get_type ())
+G_DECLARE_FINAL_TYPE (SeahorseKeyserverRefresh, seahorse_keyserver_refresh,
+                      SEAHORSE, KEYSERVER_REFRESH,
+                      GObject)
+
+SeahorseKeyserverRefresh * seahorse_keyserver_refresh_new            (SeahorseGpgmeKeyring *keyring,
+                                                                      GListModel           *remotes,
+                                                                      const char           *filename);
+
+void                       seahorse_keyserver_refresh_set_budget     (SeahorseKeyserverRefresh *self,
+                                                                      guint                     max_requests,
+                                                                      gsize                     max_bytes);
+
+void                       seahorse_keyserver_refresh_start          (SeahorseKeyserverRefresh *self,
+                                                                      guint                     period);
+
+void                       seahorse_keyserver_refresh_stop           (SeahorseKeyserverRefresh *self);
+
+GBytes *                   seahorse_keyserver_refresh_filter_changed (SeahorseKeyserverRefresh *self,
+                                                                      const char               *data,
+                                                                      gsize                     size,
+                                                                      GHashTable              **digests);
+
+void                       seahorse_keyserver_refresh_record         (SeahorseKeyserverRefresh *self,
+                                                                      const char * const       *fingerprints,
+                                                                      GHashTable               *digests);
+
+gboolean                   seahorse_keyserver_refresh_save           (SeahorseKeyserverRefresh *self,
+                                                                      GError                  **error);
@@ -26,6 +26,7 @@
 #include "seahorse-pgp-backend.h"
 #include "seahorse-gpgme-keyring.h"
 #include "seahorse-keyserver-search.h"
+#include "seahorse-merge-collection.h"
 
 #include "libseahorse/seahorse-progress.h"
 #include "libseahorse/seahorse-util.h"
@@ -256,7 +257,7 @@ seahorse_keyserver_results_constructed (GObject *obj)
 static void
 seahorse_keyserver_results_init (SeahorseKeyserverResults *self)
 {
-    self->collection = GCR_SIMPLE_COLLECTION (gcr_simple_collection_new ());
+    self->collection = seahorse_merge_collection_new ();
 }
 
 static void
@@ -0,0 +1,205 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "seahorse-ldap-entry.h"
+
+#include <string.h>
+
+static gboolean
+berval_equal (const struct berval *bv,
+              const char          *str)
+{
+    size_t len = strlen (str);
+
+    return bv->bv_len == len &&
+           g_ascii_strncasecmp (bv->bv_val, str, len) == 0;
+}
+
+/* Like atoi(), but without needing a terminated string */
+static long int
+parse_int (const struct berval *bv)
+{
+    const char *p = bv->bv_val;
+    const char *end = p + bv->bv_len;
+    gboolean negative = FALSE;
+    long int value = 0;
+
+    while (p < end && g_ascii_isspace (*p))
+        p++;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    for (; p < end && g_ascii_isdigit (*p); p++) {
+        if (value > (G_MAXINT - 9) / 10)
+            break;
+        value = value * 10 + (*p - '0');
+    }
+
+    return negative ? -value : value;
+}
+
+static gboolean
+parse_digits (const char **p,
+              const char  *end,
+              unsigned int n_digits,
+              int         *value)
+{
+    *value = 0;
+    for (unsigned int i = 0; i < n_digits; i++, (*p)++) {
+        if (*p >= end || !g_ascii_isdigit (**p))
+            return FALSE;
+        *value = *value * 10 + (**p - '0');
+    }
+    return TRUE;
+}
+
+/* Days since 1970-01-01 of a proleptic Gregorian date */
+static gint64
+days_from_civil (int year,
+                 int month,
+                 int day)
+{
+    int era, yoe, doy, doe;
+
+    year -= month <= 2;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yoe = year - era * 400;
+    doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (gint64) era * 146097 + doe - 719468;
+}
+
+/* A GeneralizedTime: YYYYMMDDHHmmssZ, which is always in UTC */
+static gint64
+parse_date (const struct berval *bv)
+{
+    const char *p = bv->bv_val;
+    const char *end = p + bv->bv_len;
+    int year, month, day, hour, min, sec;
+
+    if (!parse_digits (&p, end, 4, &year) ||
+        !parse_digits (&p, end, 2, &month) ||
+        !parse_digits (&p, end, 2, &day))
+        return 0;
+
+    /* The time of day is optional for some servers */
+    if (!parse_digits (&p, end, 2, &hour))
+        hour = 0;
+    if (!parse_digits (&p, end, 2, &min))
+        min = 0;
+    if (!parse_digits (&p, end, 2, &sec))
+        sec = 0;
+
+    if (month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour > 23 || min > 59 || sec > 60)
+        return 0;
+
+    return days_from_civil (year, month, day) * 86400 +
+           hour * 3600 + min * 60 + sec;
+}
+
+static const char *
+parse_algo (const struct berval *bv)
+{
+    if (berval_equal (bv, "DH/DSS") ||
+        berval_equal (bv, "Elg") ||
+        berval_equal (bv, "Elgamal") ||
+        berval_equal (bv, "DSS/DH"))
+        return "Elgamal";
+    if (berval_equal (bv, "RSA"))
+        return "RSA";
+    if (berval_equal (bv, "DSA"))
+        return "DSA";
+    return NULL;
+}
+
+static void
+decode_value (SeahorseLDAPEntry   *entry,
+              const struct berval *attr,
+              const struct berval *value)
+{
+    if (berval_equal (attr, "pgpcertid"))
+        entry->certid = *value;
+    else if (berval_equal (attr, "pgpuserid"))
+        entry->userid = *value;
+    else if (berval_equal (attr, "pgprevoked"))
+        entry->revoked = parse_int (value) == 1;
+    else if (berval_equal (attr, "pgpdisabled"))
+        entry->disabled = parse_int (value) == 1;
+    else if (berval_equal (attr, "pgpkeycreatetime"))
+        entry->created = parse_date (value);
+    else if (berval_equal (attr, "pgpkeyexpiretime"))
+        entry->expires = parse_date (value);
+    else if (berval_equal (attr, "pgpkeytype"))
+        entry->algo = parse_algo (value);
+    else if (berval_equal (attr, "pgpkeysize"))
+        entry->length = parse_int (value);
+}
+
+/**
+ * seahorse_ldap_entry_decode:
+ * @entry: The entry to fill in
+ * @ber: The BER of a search entry, positioned at its first attribute (as
+ *   left by ldap_get_dn_ber())
+ *
+ * Walks the attributes of a search entry once, and parses the first value
+ * of each of the PGP attributes in place. Nothing is copied or allocated.
+ *
+ * Returns: %FALSE if the entry couldn't be decoded
+ */
+gboolean
+seahorse_ldap_entry_decode (SeahorseLDAPEntry *entry,
+                            BerElement        *ber)
+{
+    ber_len_t len;
+
+    g_return_val_if_fail (entry != NULL, FALSE);
+    g_return_val_if_fail (ber != NULL, FALSE);
+
+    memset (entry, 0, sizeof (*entry));
+
+    /* PartialAttribute ::= SEQUENCE { type, vals SET OF value } */
+    while (ber_peek_tag (ber, &len) == LBER_SEQUENCE) {
+        struct berval attr;
+        ber_tag_t tag;
+        char *last;
+        gboolean first = TRUE;
+
+        if (ber_scanf (ber, "{m", &attr) == LBER_ERROR)
+            return FALSE;
+
+        for (tag = ber_first_element (ber, &len, &last);
+             tag != LBER_DEFAULT;
+             tag = ber_next_element (ber, &len, last)) {
+            struct berval value;
+
+            if (ber_scanf (ber, "m", &value) == LBER_ERROR)
+                return FALSE;
+
+            /* Only the first value counts, the others are skipped */
+            if (first)
+                decode_value (entry, &attr, &value);
+            first = FALSE;
+        }
+    }
+
+    return TRUE;
+}
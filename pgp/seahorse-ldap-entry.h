@@ -0,0 +1,46 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SeahorseLDAPEntry: The PGP attributes of an LDAP search entry
+ *
+ * - Filled in a single pass over the attributes of the entry.
+ * - The values are parsed where they are in the BER buffer; the string
+ *   fields point into it, so they're only valid as long as the message is.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+#include <lber.h>
+
+typedef struct {
+    struct berval certid;       /* pgpCertID */
+    struct berval userid;       /* pgpUserID */
+    gboolean revoked;           /* pgpRevoked */
+    gboolean disabled;          /* pgpDisabled */
+    gint64 created;             /* pgpKeyCreateTime, or 0 */
+    gint64 expires;             /* pgpKeyExpireTime, or 0 */
+    const char *algo;           /* pgpKeyType, or NULL if unknown */
+    int length;                 /* pgpKeySize */
+} SeahorseLDAPEntry;
+
+gboolean      seahorse_ldap_entry_decode        (SeahorseLDAPEntry *entry,
+                                                 BerElement        *ber);
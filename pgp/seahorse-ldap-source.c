@@ -27,6 +27,7 @@
 #include <glib/gi18n.h>
 
 #include "seahorse-ldap-source.h"
+#include "seahorse-ldap-entry.h"
 
 #include "seahorse-pgp-key.h"
 #include "seahorse-pgp-subkey.h"
@@ -44,10 +45,31 @@
 /* Amount of keys to load in a batch */
 #define DEFAULT_LOAD_BATCH 30
 
+/* Amount of entries to ask for at once when searching */
+#define DEFAULT_PAGE_SIZE 100
+
+/* Connections are kept around for a while after an operation, so back to
+ * back operations don't have to resolve, connect and bind again */
+#define POOL_MAX_IDLE           2
+#define POOL_IDLE_TIMEOUT       60      /* seconds */
+#define POOL_SWEEP_INTERVAL     15      /* seconds */
+
 struct _SeahorseLDAPSource {
     SeahorseServerSource parent;
+
+    GQueue idle;                /* of PooledConnection, most recent first */
+    guint sweep_id;
+
+    unsigned int page_size;
 };
 
+enum {
+    PROP_0,
+    PROP_PAGE_SIZE,
+    N_PROPS
+};
+static GParamSpec *obj_props[N_PROPS] = { NULL, };
+
 /* -----------------------------------------------------------------------------
  * SERVER INFO
  */
@@ -102,6 +124,115 @@ destroy_ldap (gpointer data)
         ldap_unbind_ext ((LDAP *) data, NULL, NULL);
 }
 
+/* -----------------------------------------------------------------------------
+ *  CONNECTION POOL
+ */
+
+typedef struct {
+    LDAP *ldap;
+    gint64 idle_since;
+} PooledConnection;
+
+static void
+pooled_connection_free (PooledConnection *conn)
+{
+    ldap_unbind_ext (conn->ldap, NULL, NULL);
+    g_free (conn);
+}
+
+static gboolean
+pooled_connection_expired (PooledConnection *conn,
+                           gint64            now)
+{
+    return now - conn->idle_since >= POOL_IDLE_TIMEOUT * G_USEC_PER_SEC;
+}
+
+/* An idle connection has nothing to tell us. If the socket is readable
+ * anyway, the server probably hung up (or sent a notice of disconnection). */
+static gboolean
+is_connection_healthy (LDAP *ldap)
+{
+    Sockbuf *sb = NULL;
+    GPollFD pfd;
+    int fd = -1;
+
+    if (ldap_get_option (ldap, LDAP_OPT_DESC, &fd) != LDAP_OPT_SUCCESS || fd < 0)
+        return FALSE;
+
+    if (ldap_get_option (ldap, LDAP_OPT_SOCKBUF, &sb) == LDAP_OPT_SUCCESS &&
+        sb != NULL && ber_sockbuf_ctrl (sb, LBER_SB_OPT_DATA_READY, NULL) > 0)
+        return FALSE;
+
+    pfd.fd = fd;
+    pfd.events = G_IO_IN | G_IO_HUP | G_IO_ERR;
+    pfd.revents = 0;
+    return g_poll (&pfd, 1, 0) == 0;
+}
+
+static LDAP *
+connection_pool_take (SeahorseLDAPSource *self)
+{
+    gint64 now = g_get_monotonic_time ();
+    PooledConnection *conn;
+
+    while ((conn = g_queue_pop_head (&self->idle)) != NULL) {
+        if (!pooled_connection_expired (conn, now) && is_connection_healthy (conn->ldap)) {
+            LDAP *ldap = conn->ldap;
+            g_free (conn);
+            return ldap;
+        }
+
+        g_debug ("Dropping stale LDAP connection");
+        pooled_connection_free (conn);
+    }
+
+    return NULL;
+}
+
+static gboolean
+on_connection_pool_sweep (gpointer user_data)
+{
+    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (user_data);
+    gint64 now = g_get_monotonic_time ();
+    PooledConnection *conn;
+
+    /* The ones that are idle the longest are at the tail */
+    while ((conn = g_queue_peek_tail (&self->idle)) != NULL &&
+           pooled_connection_expired (conn, now)) {
+        g_queue_pop_tail (&self->idle);
+        pooled_connection_free (conn);
+    }
+
+    if (!g_queue_is_empty (&self->idle))
+        return G_SOURCE_CONTINUE;
+
+    self->sweep_id = 0;
+    return G_SOURCE_REMOVE;
+}
+
+/* Connections are only reusable if no operation is outstanding on them */
+static void
+connection_pool_release (SeahorseLDAPSource *self,
+                         LDAP               *ldap,
+                         gboolean            reusable)
+{
+    PooledConnection *conn;
+
+    if (!reusable || self->idle.length >= POOL_MAX_IDLE) {
+        ldap_unbind_ext (ldap, NULL, NULL);
+        return;
+    }
+
+    conn = g_new0 (PooledConnection, 1);
+    conn->ldap = ldap;
+    conn->idle_since = g_get_monotonic_time ();
+    g_queue_push_head (&self->idle, conn);
+
+    if (self->sweep_id == 0)
+        self->sweep_id = g_timeout_add_seconds (POOL_SWEEP_INTERVAL,
+                                                on_connection_pool_sweep, self);
+}
+
 /* -----------------------------------------------------------------------------
  *  LDAP HELPERS
  */
@@ -180,19 +311,6 @@ get_string_attribute (LDAP *ld, LDAPMessage *res, const char *attribute)
     return v;
 }
 
-static gboolean
-get_boolean_attribute (LDAP* ld, LDAPMessage *res, const char *attribute)
-{
-    g_auto(GStrv) vals = NULL;
-    gboolean b;
-
-    vals = get_ldap_values (ld, res, attribute);
-    if (!vals)
-        return FALSE;
-    b = vals[0] && atoi (vals[0]) == 1;
-    return b;
-}
-
 static long int
 get_int_attribute (LDAP* ld, LDAPMessage *res, const char *attribute)
 {
@@ -206,60 +324,6 @@ get_int_attribute (LDAP* ld, LDAPMessage *res, const char *attribute)
     return d;
 }
 
-static long int
-get_date_attribute (LDAP* ld, LDAPMessage *res, const char *attribute)
-{
-    g_auto(GStrv) vals = NULL;
-    struct tm t;
-    long int d = 0;
-
-    vals = get_ldap_values (ld, res, attribute);
-    if (!vals)
-        return 0;
-
-    if (vals[0]) {
-        memset(&t, 0, sizeof (t));
-
-        /* YYYYMMDDHHmmssZ */
-        sscanf(vals[0], "%4d%2d%2d%2d%2d%2d",
-            &t.tm_year, &t.tm_mon, &t.tm_mday,
-            &t.tm_hour, &t.tm_min, &t.tm_sec);
-
-        t.tm_year -= 1900;
-        t.tm_isdst = -1;
-        t.tm_mon--;
-
-        d = mktime (&t);
-    }
-
-    return d;
-}
-
-static const char*
-get_algo_attribute (LDAP* ld, LDAPMessage *res, const char *attribute)
-{
-    g_auto(GStrv) vals = NULL;
-    const char *a = NULL;
-
-    vals = get_ldap_values (ld, res, attribute);
-    if (!vals)
-        return 0;
-
-    if (vals[0]) {
-        if (g_ascii_strcasecmp (vals[0], "DH/DSS") == 0 ||
-            g_ascii_strcasecmp (vals[0], "Elg") == 0 ||
-            g_ascii_strcasecmp (vals[0], "Elgamal") == 0 ||
-            g_ascii_strcasecmp (vals[0], "DSS/DH") == 0)
-            a = "Elgamal";
-        if (g_ascii_strcasecmp (vals[0], "RSA") == 0)
-            a = "RSA";
-        if (g_ascii_strcasecmp (vals[0], "DSA") == 0)
-            a = "DSA";
-    }
-
-    return a;
-}
-
 /*
  * Escapes a value so it's safe to use in an LDAP filter. Also trims
  * any spaces which cause problems with some LDAP servers.
@@ -302,29 +366,52 @@ typedef struct {
     GSource source;
     LDAP *ldap;
     int ldap_op;
+    gpointer fd_tag;            /* NULL if we have to poll */
+    gboolean more;              /* Results might be waiting already */
     GCancellable *cancellable;
     gboolean cancelled;
     int cancelled_sig;
 } SeahorseLdapGSource;
 
+static gboolean
+seahorse_ldap_gsource_ready (SeahorseLdapGSource *ldap_gsource)
+{
+    Sockbuf *sb = NULL;
+
+    if (ldap_gsource->cancelled || ldap_gsource->more)
+        return TRUE;
+
+    /* libldap (or TLS) may have read ahead more than the socket tells us */
+    if (ldap_get_option (ldap_gsource->ldap, LDAP_OPT_SOCKBUF, &sb) == LDAP_OPT_SUCCESS &&
+        sb != NULL && ber_sockbuf_ctrl (sb, LBER_SB_OPT_DATA_READY, NULL) > 0)
+        return TRUE;
+
+    return FALSE;
+}
+
 static gboolean
 seahorse_ldap_gsource_prepare (GSource *gsource,
                                int *timeout)
 {
     SeahorseLdapGSource *ldap_gsource = (SeahorseLdapGSource *)gsource;
 
-    if (ldap_gsource->cancelled)
+    if (seahorse_ldap_gsource_ready (ldap_gsource))
         return TRUE;
 
-    /* No other way, but to poll */
-    *timeout = 50;
+    /* Without a socket, there's no other way, but to poll */
+    *timeout = ldap_gsource->fd_tag ? -1 : 50;
     return FALSE;
 }
 
 static gboolean
 seahorse_ldap_gsource_check (GSource *gsource)
 {
-    return TRUE;
+    SeahorseLdapGSource *ldap_gsource = (SeahorseLdapGSource *)gsource;
+
+    if (ldap_gsource->fd_tag == NULL || seahorse_ldap_gsource_ready (ldap_gsource))
+        return TRUE;
+
+    return g_source_query_unix_fd (gsource, ldap_gsource->fd_tag) != 0;
 }
 
 static gboolean
@@ -343,6 +430,8 @@ seahorse_ldap_gsource_dispatch (GSource *gsource,
         return FALSE;
     }
 
+    ldap_gsource->more = FALSE;
+
     for (i = 0; i < DEFAULT_LOAD_BATCH; i++) {
 
         /* This effects a poll */
@@ -368,6 +457,8 @@ seahorse_ldap_gsource_dispatch (GSource *gsource,
             return G_SOURCE_REMOVE;
     }
 
+    /* Give others a chance, but come back without waiting on the socket */
+    ldap_gsource->more = TRUE;
     return G_SOURCE_CONTINUE;
 }
 
@@ -392,7 +483,14 @@ on_ldap_gsource_cancelled (GCancellable *cancellable,
                            gpointer user_data)
 {
     SeahorseLdapGSource *ldap_gsource = user_data;
+    GMainContext *context;
+
     ldap_gsource->cancelled = TRUE;
+
+    /* We might be blocked on the socket */
+    context = g_source_get_context ((GSource *)ldap_gsource);
+    if (context != NULL)
+        g_main_context_wakeup (context);
 }
 
 static GSource *
@@ -402,6 +500,7 @@ seahorse_ldap_gsource_new (LDAP *ldap,
 {
     GSource *gsource;
     SeahorseLdapGSource *ldap_gsource;
+    int fd = -1;
 
     gsource = g_source_new (&seahorse_ldap_gsource_funcs,
                             sizeof (SeahorseLdapGSource));
@@ -410,6 +509,14 @@ seahorse_ldap_gsource_new (LDAP *ldap,
     ldap_gsource->ldap = ldap;
     ldap_gsource->ldap_op = ldap_op;
 
+    /* Wake up only when the server sent something. The connection is made
+     * when the first operation is sent, so we should have a socket by now */
+    if (ldap_get_option (ldap, LDAP_OPT_DESC, &fd) == LDAP_OPT_SUCCESS && fd >= 0)
+        ldap_gsource->fd_tag = g_source_add_unix_fd (gsource, fd,
+                                                     G_IO_IN | G_IO_HUP | G_IO_ERR);
+    else
+        g_debug ("No LDAP socket available, falling back to polling");
+
     if (cancellable) {
         ldap_gsource->cancellable = g_object_ref (cancellable);
         ldap_gsource->cancelled_sig = g_cancellable_connect (cancellable,
@@ -636,17 +743,26 @@ seahorse_ldap_source_connect_async (SeahorseLDAPSource *source,
     g_autoptr(GSocketConnectable) addr = NULL;
     g_autoptr(GSocketAddressEnumerator) addr_enumer = NULL;
     g_autoptr(GError) error = NULL;
+    LDAP *ldap;
 
     task = g_task_new (source, cancellable, callback, user_data);
     g_task_set_source_tag (task, seahorse_ldap_source_connect_async);
 
-    closure = g_new0 (ConnectClosure, 1);
-    g_task_set_task_data (task, closure, connect_closure_free);
-
     /* Take the URI & turn it into a GNetworkAddress, to do address resolving */
     uri = seahorse_place_get_uri (SEAHORSE_PLACE (source));
     g_return_if_fail (uri && uri[0]);
 
+    /* Already bound, and we know the server info */
+    ldap = connection_pool_take (source);
+    if (ldap != NULL) {
+        g_debug ("Reusing connection to %s", uri);
+        g_task_return_pointer (task, ldap, destroy_ldap);
+        return;
+    }
+
+    closure = g_new0 (ConnectClosure, 1);
+    g_task_set_task_data (task, closure, connect_closure_free);
+
     addr = g_network_address_parse_uri (uri, LDAP_PORT, &error);
     if (!addr) {
       g_task_return_new_error (task, SEAHORSE_ERROR, -1,
@@ -684,11 +800,64 @@ G_DEFINE_TYPE (SeahorseLDAPSource, seahorse_ldap_source, SEAHORSE_TYPE_SERVER_SO
 static void
 seahorse_ldap_source_init (SeahorseLDAPSource *self)
 {
+    g_queue_init (&self->idle);
+    self->page_size = DEFAULT_PAGE_SIZE;
+}
+
+static void
+seahorse_ldap_source_get_property (GObject *object,
+                                   unsigned int prop_id,
+                                   GValue *value,
+                                   GParamSpec *pspec)
+{
+    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (object);
+
+    switch (prop_id) {
+    case PROP_PAGE_SIZE:
+        g_value_set_uint (value, seahorse_ldap_source_get_page_size (self));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+seahorse_ldap_source_set_property (GObject *object,
+                                   unsigned int prop_id,
+                                   const GValue *value,
+                                   GParamSpec *pspec)
+{
+    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (object);
+
+    switch (prop_id) {
+    case PROP_PAGE_SIZE:
+        seahorse_ldap_source_set_page_size (self, g_value_get_uint (value));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+seahorse_ldap_source_finalize (GObject *obj)
+{
+    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (obj);
+
+    g_clear_handle_id (&self->sweep_id, g_source_remove);
+    g_queue_clear_full (&self->idle, (GDestroyNotify) pooled_connection_free);
+
+    G_OBJECT_CLASS (seahorse_ldap_source_parent_class)->finalize (obj);
 }
 
 typedef struct {
+    SeahorseLDAPSource *source;
     char *filter;
     LDAP *ldap;
+    int ldap_op;
+    struct berval *cookie;      /* Where the next page starts */
+    gboolean reusable;
     GcrSimpleCollection *results;
 } SearchClosure;
 
@@ -698,8 +867,10 @@ search_closure_free (gpointer data)
     SearchClosure *closure = data;
     g_clear_object (&closure->results);
     g_free (closure->filter);
+    g_clear_pointer (&closure->cookie, ber_bvfree);
     if (closure->ldap)
-        ldap_unbind_ext (closure->ldap, NULL, NULL);
+        connection_pool_release (closure->source, closure->ldap, closure->reusable);
+    g_object_unref (closure->source);
     g_free (closure);
 }
 
@@ -709,7 +880,7 @@ static const char *PGP_ATTRIBUTES[] = {
     "pgprevoked",
     "pgpdisabled",
     "pgpkeycreatetime",
-    "pgpkeyexpiretime"
+    "pgpkeyexpiretime",
     "pgpkeysize",
     "pgpkeytype",
     NULL
@@ -722,25 +893,29 @@ search_parse_key_from_ldap_entry (SeahorseLDAPSource *self,
                                   LDAP *ldap,
                                   LDAPMessage *res)
 {
-    const char *algo;
-    long int timestamp;
-    long int expires;
+    SeahorseLDAPEntry entry;
+    BerElement *ber = NULL;
+    struct berval dn;
     g_autofree char *fpr = NULL;
     g_autofree char *uidstr = NULL;
-    gboolean revoked;
-    gboolean disabled;
-    int length;
+    gboolean decoded;
 
     g_return_if_fail (ldap_msgtype (res) == LDAP_RES_SEARCH_ENTRY);
 
-    fpr = get_string_attribute (ldap, res, "pgpcertid");
-    uidstr = get_string_attribute (ldap, res, "pgpuserid");
-    revoked = get_boolean_attribute (ldap, res, "pgprevoked");
-    disabled = get_boolean_attribute (ldap, res, "pgpdisabled");
-    timestamp = get_date_attribute (ldap, res, "pgpkeycreatetime");
-    expires = get_date_attribute (ldap, res, "pgpkeyexpiretime");
-    algo = get_algo_attribute (ldap, res, "pgpkeytype");
-    length = get_int_attribute (ldap, res, "pgpkeysize");
+    if (ldap_get_dn_ber (ldap, res, &ber, &dn) != LDAP_SUCCESS)
+        return;
+    decoded = seahorse_ldap_entry_decode (&entry, ber);
+    ber_free (ber, 0);
+    if (!decoded) {
+        g_message ("Couldn't decode LDAP entry: %.*s", (int) dn.bv_len, dn.bv_val);
+        return;
+    }
+
+    /* These are the only values the key needs a copy of */
+    if (entry.certid.bv_val)
+        fpr = g_strndup (entry.certid.bv_val, entry.certid.bv_len);
+    if (entry.userid.bv_val)
+        uidstr = g_strndup (entry.userid.bv_val, entry.userid.bv_len);
 
     if (fpr && uidstr) {
         g_autoptr (SeahorsePgpSubkey) subkey = NULL;
@@ -754,24 +929,24 @@ search_parse_key_from_ldap_entry (SeahorseLDAPSource *self,
         seahorse_pgp_subkey_set_keyid (subkey, fpr);
         fingerprint = seahorse_pgp_subkey_calc_fingerprint (fpr);
         seahorse_pgp_subkey_set_fingerprint (subkey, fingerprint);
-        seahorse_pgp_subkey_set_algorithm (subkey, algo);
-        seahorse_pgp_subkey_set_length (subkey, length);
+        seahorse_pgp_subkey_set_algorithm (subkey, entry.algo);
+        seahorse_pgp_subkey_set_length (subkey, entry.length);
 
-        if (timestamp > 0) {
+        if (entry.created > 0) {
             g_autoptr(GDateTime) created_date = NULL;
-            created_date = g_date_time_new_from_unix_utc (timestamp);
+            created_date = g_date_time_new_from_unix_utc (entry.created);
             seahorse_pgp_subkey_set_created (subkey, created_date);
         }
-        if (expires > 0) {
+        if (entry.expires > 0) {
             g_autoptr(GDateTime) expires_date = NULL;
-            expires_date = g_date_time_new_from_unix_utc (expires);
+            expires_date = g_date_time_new_from_unix_utc (entry.expires);
             seahorse_pgp_subkey_set_expires (subkey, expires_date);
         }
 
         flags = SEAHORSE_FLAG_EXPORTABLE;
-        if (revoked)
+        if (entry.revoked)
             flags |= SEAHORSE_FLAG_REVOKED;
-        if (disabled)
+        if (entry.disabled)
             flags |= SEAHORSE_FLAG_DISABLED;
         seahorse_pgp_subkey_set_flags (subkey, flags);
 
@@ -779,7 +954,7 @@ search_parse_key_from_ldap_entry (SeahorseLDAPSource *self,
 
         /* Build up a uid */
         uid = seahorse_pgp_uid_new (key, uidstr);
-        if (revoked)
+        if (entry.revoked)
             seahorse_pgp_uid_set_validity (uid, SEAHORSE_VALIDITY_REVOKED);
         seahorse_pgp_key_add_uid (key, uid);
 
@@ -795,6 +970,34 @@ search_parse_key_from_ldap_entry (SeahorseLDAPSource *self,
     }
 }
 
+static void     search_send_page        (SeahorseLDAPSource *self,
+                                         GTask *task);
+
+/* Remembers where the next page starts, if the server told us */
+static gboolean
+search_parse_page_cookie (SearchClosure *closure,
+                          LDAPControl  **controls)
+{
+    LDAPControl *control;
+    struct berval cookie = { 0, NULL };
+    ber_int_t count;
+
+    g_clear_pointer (&closure->cookie, ber_bvfree);
+
+    control = ldap_control_find (LDAP_CONTROL_PAGEDRESULTS, controls, NULL);
+    if (control == NULL)
+        return FALSE;
+
+    if (ldap_parse_pageresponse_control (closure->ldap, control, &count, &cookie) != LDAP_SUCCESS)
+        return FALSE;
+
+    if (cookie.bv_val != NULL && cookie.bv_len > 0)
+        closure->cookie = ber_bvdup (&cookie);
+    ber_memfree (cookie.bv_val);
+
+    return closure->cookie != NULL;
+}
+
 static gboolean
 on_search_search_completed (LDAPMessage *result,
                             gpointer user_data)
@@ -804,11 +1007,21 @@ on_search_search_completed (LDAPMessage *result,
     SearchClosure *closure = g_task_get_task_data (task);
     GCancellable *cancellable = g_task_get_cancellable (task);
     g_autoptr(GError) error = NULL;
+    LDAPControl **controls = NULL;
+    gboolean more;
     int type;
     int rc;
     int code;
     char *message;
 
+    /* Cancelled: stop right away, the connection won't be reused */
+    if (result == NULL) {
+        ldap_abandon_ext (closure->ldap, closure->ldap_op, NULL, NULL);
+        g_task_return_error_if_cancelled (task);
+        seahorse_progress_end (cancellable, task);
+        return G_SOURCE_REMOVE;
+    }
+
     type = ldap_msgtype (result);
     g_return_val_if_fail (type == LDAP_RES_SEARCH_ENTRY || type == LDAP_RES_SEARCH_RESULT, FALSE);
 
@@ -824,11 +1037,22 @@ on_search_search_completed (LDAPMessage *result,
         return G_SOURCE_CONTINUE;
     }
 
-    /* All entries done */
+    /* All entries of this page done */
     rc = ldap_parse_result (closure->ldap, result, &code, NULL,
-                            &message, NULL, NULL, 0);
+                            &message, NULL, &controls, 0);
     g_return_val_if_fail (rc == LDAP_SUCCESS, FALSE);
 
+    more = (code == LDAP_SUCCESS && search_parse_page_cookie (closure, controls));
+    ldap_controls_free (controls);
+
+    if (more) {
+        ldap_memfree (message);
+        search_send_page (self, task);
+        return G_SOURCE_REMOVE;
+    }
+
+    closure->reusable = TRUE;
+
     /* Error codes that we ignore */
     switch (code) {
     case LDAP_SIZELIMIT_EXCEEDED:
@@ -850,46 +1074,73 @@ on_search_search_completed (LDAPMessage *result,
 }
 
 static void
-on_search_connect_completed (GObject *source,
-                             GAsyncResult *result,
-                             gpointer user_data)
+search_send_page (SeahorseLDAPSource *self,
+                  GTask *task)
 {
-    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (source);
-    g_autoptr(GTask) task = G_TASK (user_data);
     SearchClosure *closure = g_task_get_task_data (task);
     GCancellable *cancellable = g_task_get_cancellable (task);
+    LDAPControl *server_controls[2] = { NULL, NULL };
     g_autoptr(GError) error = NULL;
+    g_autoptr(GSource) gsource = NULL;
     LDAPServerInfo *sinfo;
-    int ldap_op;
     int rc;
-    g_autoptr(GSource) gsource = NULL;
 
-    closure->ldap = seahorse_ldap_source_connect_finish (self, result, &error);
-    if (error != NULL) {
-        g_task_return_error (task, g_steal_pointer (&error));
+    if (g_task_return_error_if_cancelled (task)) {
+        seahorse_progress_end (cancellable, task);
         return;
     }
 
     sinfo = get_ldap_server_info (self, TRUE);
 
-    g_debug ("Searching Server ... base: %s, filter: %s",
-             sinfo->base_dn, closure->filter);
+    g_debug ("Searching Server ... base: %s, filter: %s, page size: %u",
+             sinfo->base_dn, closure->filter, self->page_size);
+
+    /* Servers that don't support paging just return everything */
+    if (self->page_size > 0) {
+        rc = ldap_create_page_control (closure->ldap, self->page_size,
+                                       closure->cookie, 0, &server_controls[0]);
+        if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
+            g_task_return_error (task, g_steal_pointer (&error));
+            return;
+        }
+    }
 
     rc = ldap_search_ext (closure->ldap, sinfo->base_dn, LDAP_SCOPE_SUBTREE,
                           closure->filter, (char **)PGP_ATTRIBUTES, 0,
-                          NULL, NULL, NULL, 0, &ldap_op);
+                          server_controls[0] ? server_controls : NULL,
+                          NULL, NULL, 0, &closure->ldap_op);
+    g_clear_pointer (&server_controls[0], ldap_control_free);
 
     if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
         g_task_return_error (task, g_steal_pointer (&error));
         return;
     }
 
-    gsource = seahorse_ldap_gsource_new (closure->ldap, ldap_op, cancellable);
+    gsource = seahorse_ldap_gsource_new (closure->ldap, closure->ldap_op, cancellable);
     g_source_set_callback (gsource, G_SOURCE_FUNC (on_search_search_completed),
-                           g_steal_pointer (&task), g_object_unref);
+                           g_object_ref (task), g_object_unref);
     g_source_attach (gsource, g_main_context_default ());
 }
 
+static void
+on_search_connect_completed (GObject *source,
+                             GAsyncResult *result,
+                             gpointer user_data)
+{
+    SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (source);
+    g_autoptr(GTask) task = G_TASK (user_data);
+    SearchClosure *closure = g_task_get_task_data (task);
+    g_autoptr(GError) error = NULL;
+
+    closure->ldap = seahorse_ldap_source_connect_finish (self, result, &error);
+    if (error != NULL) {
+        g_task_return_error (task, g_steal_pointer (&error));
+        return;
+    }
+
+    search_send_page (self, task);
+}
+
 
 static void
 seahorse_ldap_source_search_async (SeahorseServerSource *source,
@@ -907,6 +1158,7 @@ seahorse_ldap_source_search_async (SeahorseServerSource *source,
     task = g_task_new (source, cancellable, callback, user_data);
     g_task_set_source_tag (task, seahorse_ldap_source_search_async);
     closure = g_new0 (SearchClosure, 1);
+    closure->source = g_object_ref (self);
     closure->results = g_object_ref (results);
     text = escape_ldap_value (match);
     closure->filter = g_strdup_printf ("(pgpuserid=*%s*)", text);
@@ -930,10 +1182,18 @@ seahorse_ldap_source_search_finish (SeahorseServerSource *source,
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+/* The amount of keys to have outstanding on the connection at once */
+#define IMPORT_MAX_ADDS 16
+
 typedef struct {
+    SeahorseLDAPSource *source;
     GPtrArray *keydatas;
-    int current_index;
+    GPtrArray *fingerprints;    /* Of the keydatas, for reporting */
+    unsigned int next_index;    /* The first key that wasn't sent yet */
+    GHashTable *adds;           /* message id → index of its key */
+    GPtrArray *failures;        /* Messages for the keys that didn't make it */
     LDAP *ldap;
+    gboolean reusable;
 } ImportClosure;
 
 static void
@@ -941,12 +1201,89 @@ import_closure_free (gpointer data)
 {
     ImportClosure *closure = data;
     g_ptr_array_free (closure->keydatas, TRUE);
+    g_ptr_array_free (closure->fingerprints, TRUE);
+    g_hash_table_unref (closure->adds);
+    g_ptr_array_free (closure->failures, TRUE);
     if (closure->ldap)
-        ldap_unbind_ext (closure->ldap, NULL, NULL);
+        connection_pool_release (closure->source, closure->ldap, closure->reusable);
+    g_object_unref (closure->source);
     g_free (closure);
 }
 
-static void import_send_key (SeahorseLDAPSource *self, GTask *task);
+/* Keeps up to IMPORT_MAX_ADDS keys outstanding */
+static gboolean
+import_send_keys (SeahorseLDAPSource *self,
+                  GTask *task)
+{
+    ImportClosure *closure = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
+    LDAPServerInfo *sinfo;
+    g_autofree char *base = NULL;
+
+    sinfo = get_ldap_server_info (self, TRUE);
+    base = g_strdup_printf ("pgpCertid=virtual,%s", sinfo->base_dn);
+
+    while (g_hash_table_size (closure->adds) < IMPORT_MAX_ADDS &&
+           closure->next_index < closure->keydatas->len) {
+        unsigned int index = closure->next_index++;
+        char *keydata = g_ptr_array_index (closure->keydatas, index);
+        g_autoptr(GError) error = NULL;
+        LDAPMod mod;
+        LDAPMod *attrs[2];
+        char *values[2];
+        int ldap_op;
+        int rc;
+
+        seahorse_progress_begin (cancellable, keydata);
+        values[0] = keydata;
+        values[1] = NULL;
+
+        memset (&mod, 0, sizeof (mod));
+        mod.mod_op = LDAP_MOD_ADD;
+        mod.mod_type = sinfo->key_attr;
+        mod.mod_values = values;
+
+        attrs[0] = &mod;
+        attrs[1] = NULL;
+
+        rc = ldap_add_ext (closure->ldap, base, attrs, NULL, NULL, &ldap_op);
+
+        /* This is about the connection, not about the key */
+        if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
+            g_task_return_error (task, g_steal_pointer (&error));
+            return FALSE;
+        }
+
+        g_hash_table_insert (closure->adds,
+                             GINT_TO_POINTER (ldap_op), GUINT_TO_POINTER (index));
+    }
+
+    return TRUE;
+}
+
+static void
+import_complete (GTask *task)
+{
+    ImportClosure *closure = g_task_get_task_data (task);
+    g_autofree char *details = NULL;
+    unsigned int n_failed = closure->failures->len;
+    unsigned int n_keys = closure->keydatas->len;
+
+    closure->reusable = TRUE;
+
+    if (n_failed == 0) {
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    g_ptr_array_add (closure->failures, NULL);
+    details = g_strjoinv ("\n", (char **) closure->failures->pdata);
+    g_task_return_new_error (task, LDAP_ERROR_DOMAIN, LDAP_OTHER,
+                             ngettext ("Couldn’t send %u key out of %u:\n%s",
+                                       "Couldn’t send %u keys out of %u:\n%s",
+                                       n_failed),
+                             n_failed, n_keys, details);
+}
 
 /* Called when results come in for a key send */
 static gboolean
@@ -955,88 +1292,62 @@ on_import_add_completed (LDAPMessage *result,
 {
     GTask *task = G_TASK (user_data);
     ImportClosure *closure = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
     SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (g_task_get_source_object (task));
-    GError *error = NULL;
+    const char *fingerprint;
+    gpointer index_ptr;
+    unsigned int index;
     char *message;
     int code;
     int rc;
 
+    /* Cancelled, the connection won't be reused */
+    if (result == NULL) {
+        g_task_return_error_if_cancelled (task);
+        return G_SOURCE_REMOVE;
+    }
+
+    if (!g_hash_table_lookup_extended (closure->adds,
+                                       GINT_TO_POINTER (ldap_msgid (result)),
+                                       NULL, &index_ptr))
+        return G_SOURCE_CONTINUE;
+    index = GPOINTER_TO_UINT (index_ptr);
+    g_hash_table_remove (closure->adds, GINT_TO_POINTER (ldap_msgid (result)));
+
     g_return_val_if_fail (ldap_msgtype (result) == LDAP_RES_ADD, FALSE);
 
     rc = ldap_parse_result (closure->ldap, result, &code, NULL,
                             &message, NULL, NULL, 0);
     g_return_val_if_fail (rc == LDAP_SUCCESS, FALSE);
 
+    fingerprint = g_ptr_array_index (closure->fingerprints, index);
+
     /* TODO: Somehow communicate this to the user */
     if (code == LDAP_ALREADY_EXISTS)
         code = LDAP_SUCCESS;
 
-    ldap_memfree (message);
+    if (code != LDAP_SUCCESS) {
+        const char *reason = (message && *message) ? message : ldap_err2string (code);
 
-    if (seahorse_ldap_source_propagate_error (self, code, &error)) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return G_SOURCE_REMOVE;
+        g_message ("Couldn't send key %s: %s", fingerprint, reason);
+        g_ptr_array_add (closure->failures,
+                         g_strdup_printf ("%s: %s", fingerprint, reason));
+    } else {
+        g_debug ("Sent key %s to LDAP server", fingerprint);
     }
 
-    import_send_key (self, task);
-    return G_SOURCE_REMOVE;
-}
-
-static void
-import_send_key (SeahorseLDAPSource *self, GTask *task)
-{
-    ImportClosure *closure = g_task_get_task_data (task);
-    GCancellable *cancellable = g_task_get_cancellable (task);
-    LDAPServerInfo *sinfo;
-    g_autofree char *base = NULL;
-    LDAPMod mod;
-    LDAPMod *attrs[2];
-    char *values[2];
-    g_autoptr(GSource) gsource = NULL;
-    GError *error = NULL;
-    char *keydata;
-    int ldap_op;
-    int rc;
-
-    if (closure->current_index >= 0) {
-        keydata = g_ptr_array_index (closure->keydatas, closure->current_index);
-        seahorse_progress_end (cancellable, keydata);
-    }
-
-    closure->current_index++;
-
-    /* All done, complete operation */
-    if (closure->current_index == (int) closure->keydatas->len) {
-        g_task_return_boolean (task, TRUE);
-        return;
-    }
-
-    keydata = g_ptr_array_index (closure->keydatas, closure->current_index);
-    seahorse_progress_begin (cancellable, keydata);
-    values[0] = keydata;
-    values[1] = NULL;
-
-    sinfo = get_ldap_server_info (self, TRUE);
-    memset (&mod, 0, sizeof (mod));
-    mod.mod_op = LDAP_MOD_ADD;
-    mod.mod_type = sinfo->key_attr;
-    mod.mod_values = values;
-
-    attrs[0] = &mod;
-    attrs[1] = NULL;
+    ldap_memfree (message);
+    seahorse_progress_end (cancellable, g_ptr_array_index (closure->keydatas, index));
 
-    base = g_strdup_printf ("pgpCertid=virtual,%s", sinfo->base_dn);
-    rc = ldap_add_ext (closure->ldap, base, attrs, NULL, NULL, &ldap_op);
+    /* Keep the window filled */
+    if (!import_send_keys (self, task))
+        return G_SOURCE_REMOVE;
 
-    if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return;
-    }
+    if (g_hash_table_size (closure->adds) > 0)
+        return G_SOURCE_CONTINUE;
 
-    gsource = seahorse_ldap_gsource_new (closure->ldap, ldap_op, cancellable);
-    g_source_set_callback (gsource, G_SOURCE_FUNC (on_import_add_completed),
-                           g_object_ref (task), g_object_unref);
-    g_source_attach (gsource, g_main_context_default ());
+    import_complete (task);
+    return G_SOURCE_REMOVE;
 }
 
 static void
@@ -1048,6 +1359,7 @@ on_import_connect_completed (GObject *source,
     ImportClosure *closure = g_task_get_task_data (task);
     SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (source);
     g_autoptr(GError) error = NULL;
+    g_autoptr(GSource) gsource = NULL;
 
     closure->ldap = seahorse_ldap_source_connect_finish (self, result, &error);
     if (error != NULL) {
@@ -1055,7 +1367,20 @@ on_import_connect_completed (GObject *source,
         return;
     }
 
-    import_send_key (self, task);
+    if (!import_send_keys (self, task))
+        return;
+
+    if (g_hash_table_size (closure->adds) == 0) {
+        import_complete (task);
+        return;
+    }
+
+    /* A single source for all the adds, matched up by message id */
+    gsource = seahorse_ldap_gsource_new (closure->ldap, LDAP_RES_ANY,
+                                         g_task_get_cancellable (task));
+    g_source_set_callback (gsource, G_SOURCE_FUNC (on_import_add_completed),
+                           g_steal_pointer (&task), g_object_unref);
+    g_source_attach (gsource, g_main_context_default ());
 }
 
 static void
@@ -1073,14 +1398,18 @@ seahorse_ldap_source_import_async (SeahorseServerSource *source,
     g_task_set_source_tag (task, seahorse_ldap_source_import_async);
 
     closure = g_new0 (ImportClosure, 1);
-    closure->current_index = -1;
+    closure->source = g_object_ref (self);
+    closure->adds = g_hash_table_new (NULL, NULL);
+    closure->failures = g_ptr_array_new_with_free_func (g_free);
     g_task_set_task_data (task, closure, import_closure_free);
 
     closure->keydatas = g_ptr_array_new_with_free_func (g_free);
+    closure->fingerprints = g_ptr_array_new_with_free_func (g_free);
     for (;;) {
         g_autoptr(GString) buf = g_string_sized_new (2048);
         guint len;
         g_autofree char *keydata = NULL;
+        char *fingerprint;
 
         len = seahorse_util_read_data_block (buf, input, "-----BEGIN PGP PUBLIC KEY BLOCK-----",
                                              "-----END PGP PUBLIC KEY BLOCK-----");
@@ -1088,7 +1417,12 @@ seahorse_ldap_source_import_async (SeahorseServerSource *source,
             break;
 
         keydata = g_string_free (g_steal_pointer (&buf), FALSE);
-        seahorse_progress_prep (cancellable, keydata, NULL);
+        fingerprint = seahorse_server_source_calc_armor_fingerprint (keydata);
+        if (fingerprint == NULL)
+            fingerprint = g_strdup_printf ("#%u", closure->keydatas->len + 1);
+        g_ptr_array_add (closure->fingerprints, fingerprint);
+
+        seahorse_progress_prep (cancellable, keydata, _("Sending key %s"), fingerprint);
         g_ptr_array_add (closure->keydatas, g_steal_pointer (&keydata));
     }
 
@@ -1113,11 +1447,19 @@ seahorse_ldap_source_import_finish (SeahorseServerSource *source,
     return NULL;
 }
 
+/* Key ids to fetch with a single search, and the amount of those searches
+ * to have outstanding on the connection at once */
+#define EXPORT_BATCH_SIZE       32
+#define EXPORT_MAX_SEARCHES     4
+
 typedef struct {
+    SeahorseLDAPSource *source;
     GPtrArray *fingerprints;
-    int current_index;
+    unsigned int next_index;    /* The first key that wasn't asked for yet */
+    GHashTable *searches;       /* message id → index of its first key */
     GString *data;
     LDAP *ldap;
+    gboolean reusable;
 } ExportClosure;
 
 static void
@@ -1125,15 +1467,75 @@ export_closure_free (gpointer data)
 {
     ExportClosure *closure = data;
     g_ptr_array_free (closure->fingerprints, TRUE);
+    g_hash_table_unref (closure->searches);
     if (closure->data)
         g_string_free (closure->data, TRUE);
     if (closure->ldap)
-        ldap_unbind_ext (closure->ldap, NULL, NULL);
+        connection_pool_release (closure->source, closure->ldap, closure->reusable);
+    g_object_unref (closure->source);
     g_free (closure);
 }
 
-static void     export_retrieve_key     (SeahorseLDAPSource *self,
-                                         GTask *task);
+static inline unsigned int
+export_batch_length (ExportClosure *closure,
+                     unsigned int   first)
+{
+    return MIN (EXPORT_BATCH_SIZE, closure->fingerprints->len - first);
+}
+
+/* Asks for the next batches of keys, each with a single search */
+static gboolean
+export_send_searches (SeahorseLDAPSource *self,
+                      GTask *task)
+{
+    ExportClosure *closure = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
+    LDAPServerInfo *sinfo;
+    char *attrs[2];
+    g_autoptr(GError) error = NULL;
+
+    sinfo = get_ldap_server_info (self, TRUE);
+    attrs[0] = sinfo->key_attr;
+    attrs[1] = NULL;
+
+    while (g_hash_table_size (closure->searches) < EXPORT_MAX_SEARCHES &&
+           closure->next_index < closure->fingerprints->len) {
+        unsigned int first = closure->next_index;
+        unsigned int length = export_batch_length (closure, first);
+        g_autoptr(GString) filter = g_string_new (NULL);
+        int ldap_op;
+        int rc;
+
+        if (length > 1)
+            g_string_append (filter, "(|");
+        for (unsigned int i = first; i < first + length; i++) {
+            const char *fingerprint = g_ptr_array_index (closure->fingerprints, i);
+            size_t fpr_len = strlen (fingerprint);
+
+            seahorse_progress_begin (cancellable, fingerprint);
+            if (fpr_len > 16)
+                fingerprint += (fpr_len - 16);
+            g_string_append_printf (filter, "(pgpcertid=%.16s)", fingerprint);
+        }
+        if (length > 1)
+            g_string_append_c (filter, ')');
+
+        rc = ldap_search_ext (closure->ldap, sinfo->base_dn, LDAP_SCOPE_SUBTREE,
+                              filter->str, attrs, 0,
+                              NULL, NULL, NULL, 0, &ldap_op);
+
+        if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
+            g_task_return_error (task, g_steal_pointer (&error));
+            return FALSE;
+        }
+
+        g_hash_table_insert (closure->searches,
+                             GINT_TO_POINTER (ldap_op), GUINT_TO_POINTER (first));
+        closure->next_index += length;
+    }
+
+    return TRUE;
+}
 
 static gboolean
 on_export_search_completed (LDAPMessage *result,
@@ -1141,14 +1543,29 @@ on_export_search_completed (LDAPMessage *result,
 {
     GTask *task = G_TASK (user_data);
     ExportClosure *closure = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
     SeahorseLDAPSource *self = SEAHORSE_LDAP_SOURCE (g_task_get_source_object (task));
     LDAPServerInfo *sinfo;
+    gpointer first_ptr;
+    unsigned int first;
     char *message;
     GError *error = NULL;
     int code;
     int type;
     int rc;
 
+    /* Cancelled, the connection won't be reused */
+    if (result == NULL) {
+        g_task_return_error_if_cancelled (task);
+        return G_SOURCE_REMOVE;
+    }
+
+    if (!g_hash_table_lookup_extended (closure->searches,
+                                       GINT_TO_POINTER (ldap_msgid (result)),
+                                       NULL, &first_ptr))
+        return G_SOURCE_CONTINUE;
+    first = GPOINTER_TO_UINT (first_ptr);
+
     type = ldap_msgtype (result);
     g_return_val_if_fail (type == LDAP_RES_SEARCH_ENTRY || type == LDAP_RES_SEARCH_RESULT, FALSE);
     sinfo = get_ldap_server_info (self, TRUE);
@@ -1176,78 +1593,32 @@ on_export_search_completed (LDAPMessage *result,
         return G_SOURCE_CONTINUE;
     }
 
-    /* No more entries, result */
+    /* No more entries for this batch, result */
     rc = ldap_parse_result (closure->ldap, result, &code, NULL,
                             &message, NULL, NULL, 0);
     g_return_val_if_fail (rc == LDAP_SUCCESS, FALSE);
+    ldap_memfree (message);
 
     if (seahorse_ldap_source_propagate_error (self, code, &error)) {
         g_task_return_error (task, g_steal_pointer (&error));
         return G_SOURCE_REMOVE;
     }
 
-    ldap_memfree (message);
-
-    /* Process more keys if possible */
-    export_retrieve_key (self, task);
-    return G_SOURCE_REMOVE;
-}
+    for (unsigned int i = first; i < first + export_batch_length (closure, first); i++)
+        seahorse_progress_end (cancellable, g_ptr_array_index (closure->fingerprints, i));
+    g_hash_table_remove (closure->searches, GINT_TO_POINTER (ldap_msgid (result)));
 
-static void
-export_retrieve_key (SeahorseLDAPSource *self,
-                     GTask *task)
-{
-    ExportClosure *closure = g_task_get_task_data (task);
-    GCancellable *cancellable = g_task_get_cancellable (task);
-    LDAPServerInfo *sinfo;
-    g_autofree char *filter = NULL;
-    char *attrs[2];
-    g_autoptr(GSource) gsource = NULL;
-    const char *fingerprint;
-    g_autoptr(GError) error = NULL;
-    int length, rc;
-    int ldap_op;
-
-    if (closure->current_index > 0) {
-        fingerprint = g_ptr_array_index (closure->fingerprints,
-                                         closure->current_index);
-        seahorse_progress_end (cancellable, fingerprint);
-    }
+    /* Keep the pipeline filled */
+    if (!export_send_searches (self, task))
+        return G_SOURCE_REMOVE;
 
-    closure->current_index++;
+    if (g_hash_table_size (closure->searches) > 0)
+        return G_SOURCE_CONTINUE;
 
     /* All done, complete operation */
-    if (closure->current_index == (int) closure->fingerprints->len) {
-        g_task_return_boolean (task, TRUE);
-        return;
-    }
-
-    fingerprint = g_ptr_array_index (closure->fingerprints,
-                                     closure->current_index);
-    seahorse_progress_begin (cancellable, fingerprint);
-    length = strlen (fingerprint);
-    if (length > 16)
-        fingerprint += (length - 16);
-
-    filter = g_strdup_printf ("(pgpcertid=%.16s)", fingerprint);
-    sinfo = get_ldap_server_info (self, TRUE);
-
-    attrs[0] = sinfo->key_attr;
-    attrs[1] = NULL;
-
-    rc = ldap_search_ext (closure->ldap, sinfo->base_dn, LDAP_SCOPE_SUBTREE,
-                          filter, attrs, 0,
-                          NULL, NULL, NULL, 0, &ldap_op);
-
-    if (seahorse_ldap_source_propagate_error (self, rc, &error)) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return;
-    }
-
-    gsource = seahorse_ldap_gsource_new (closure->ldap, ldap_op, cancellable);
-    g_source_set_callback (gsource, (GSourceFunc)on_export_search_completed,
-                           g_object_ref (task), g_object_unref);
-    g_source_attach (gsource, g_main_context_default ());
+    closure->reusable = TRUE;
+    g_task_return_boolean (task, TRUE);
+    return G_SOURCE_REMOVE;
 }
 
 static void
@@ -1259,6 +1630,7 @@ on_export_connect_completed (GObject *source,
     g_autoptr(GTask) task = G_TASK (user_data);
     ExportClosure *closure = g_task_get_task_data (task);
     g_autoptr(GError) error = NULL;
+    g_autoptr(GSource) gsource = NULL;
 
     closure->ldap = seahorse_ldap_source_connect_finish (self, result, &error);
     if (error != NULL) {
@@ -1266,7 +1638,21 @@ on_export_connect_completed (GObject *source,
         return;
     }
 
-    export_retrieve_key (self, task);
+    if (!export_send_searches (self, task))
+        return;
+
+    if (g_hash_table_size (closure->searches) == 0) {
+        closure->reusable = TRUE;
+        g_task_return_boolean (task, TRUE);
+        return;
+    }
+
+    /* A single source for all the searches, matched up by message id */
+    gsource = seahorse_ldap_gsource_new (closure->ldap, LDAP_RES_ANY,
+                                         g_task_get_cancellable (task));
+    g_source_set_callback (gsource, (GSourceFunc)on_export_search_completed,
+                           g_steal_pointer (&task), g_object_unref);
+    g_source_attach (gsource, g_main_context_default ());
 }
 
 static void
@@ -1284,7 +1670,9 @@ seahorse_ldap_source_export_async (SeahorseServerSource *source,
     g_task_set_source_tag (task, seahorse_ldap_source_export_async);
 
     closure = g_new0 (ExportClosure, 1);
+    closure->source = g_object_ref (self);
     closure->data = g_string_sized_new (1024);
+    closure->searches = g_hash_table_new (NULL, NULL);
     closure->fingerprints = g_ptr_array_new_with_free_func (g_free);
     for (int i = 0; keyids[i] != NULL; i++) {
         char *fingerprint = g_strdup (keyids[i]);
@@ -1292,7 +1680,6 @@ seahorse_ldap_source_export_async (SeahorseServerSource *source,
         g_ptr_array_add (closure->fingerprints, fingerprint);
         seahorse_progress_prep (cancellable, fingerprint, NULL);
     }
-    closure->current_index = -1;
     g_task_set_task_data (task, closure, export_closure_free);
 
     seahorse_ldap_source_connect_async (self, cancellable,
@@ -1326,14 +1713,27 @@ seahorse_ldap_source_export_finish (SeahorseServerSource *source,
 static void
 seahorse_ldap_source_class_init (SeahorseLDAPSourceClass *klass)
 {
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
     SeahorseServerSourceClass *server_class = SEAHORSE_SERVER_SOURCE_CLASS (klass);
 
+    gobject_class->get_property = seahorse_ldap_source_get_property;
+    gobject_class->set_property = seahorse_ldap_source_set_property;
+    gobject_class->finalize = seahorse_ldap_source_finalize;
+
     server_class->search_async = seahorse_ldap_source_search_async;
     server_class->search_finish = seahorse_ldap_source_search_finish;
     server_class->export_async = seahorse_ldap_source_export_async;
     server_class->export_finish = seahorse_ldap_source_export_finish;
     server_class->import_async = seahorse_ldap_source_import_async;
     server_class->import_finish = seahorse_ldap_source_import_finish;
+
+    obj_props[PROP_PAGE_SIZE] =
+        g_param_spec_uint ("page-size", "Page size",
+                           "Amount of search results to ask for at once, or 0 to not page",
+                           0, G_MAXINT, DEFAULT_PAGE_SIZE,
+                           G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties (gobject_class, N_PROPS, obj_props);
 }
 
 /**
@@ -1352,6 +1752,43 @@ seahorse_ldap_source_new (const char *uri)
     return g_object_new (SEAHORSE_TYPE_LDAP_SOURCE, "uri", uri, NULL);
 }
 
+/**
+ * seahorse_ldap_source_get_page_size:
+ * @self: A #SeahorseLDAPSource
+ *
+ * Returns: The amount of search results asked for at once, or 0 if
+ *   searches aren't paged
+ */
+unsigned int
+seahorse_ldap_source_get_page_size (SeahorseLDAPSource *self)
+{
+    g_return_val_if_fail (SEAHORSE_IS_LDAP_SOURCE (self), 0);
+    return self->page_size;
+}
+
+/**
+ * seahorse_ldap_source_set_page_size:
+ * @self: A #SeahorseLDAPSource
+ * @page_size: The amount of search results to ask for at once, or 0 to
+ *   get them all in one go
+ *
+ * Sets the page size of searches (see RFC 2696). Paging keeps broad
+ * searches below the size limits of the server.
+ */
+void
+seahorse_ldap_source_set_page_size (SeahorseLDAPSource *self,
+                                    unsigned int        page_size)
+{
+    g_return_if_fail (SEAHORSE_IS_LDAP_SOURCE (self));
+    g_return_if_fail (page_size <= G_MAXINT);
+
+    if (self->page_size == page_size)
+        return;
+
+    self->page_size = page_size;
+    g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_PAGE_SIZE]);
+}
+
 /**
  * seahorse_ldap_is_valid_uri
  * @uri: The uri to check
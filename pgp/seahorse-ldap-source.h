@@ -35,8 +35,13 @@ G_DECLARE_FINAL_TYPE (SeahorseLDAPSource, seahorse_ldap_source,
                       SEAHORSE, LDAP_SOURCE,
                       SeahorseServerSource)
 
-SeahorseLDAPSource*   seahorse_ldap_source_new     (const char *uri);
+SeahorseLDAPSource*   seahorse_ldap_source_new            (const char *uri);
 
-gboolean              seahorse_ldap_is_valid_uri   (const char *uri);
+unsigned int          seahorse_ldap_source_get_page_size  (SeahorseLDAPSource *self);
+
+void                  seahorse_ldap_source_set_page_size  (SeahorseLDAPSource *self,
+                                                           unsigned int        page_size);
+
+gboolean              seahorse_ldap_is_valid_uri          (const char *uri);
 
 #endif /* WITH_LDAP */
@@ -0,0 +1,305 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "seahorse-merge-collection.h"
+
+#include "seahorse-pgp-subkey.h"
+#include "seahorse-pgp-uid.h"
+
+#include <string.h>
+
+struct _SeahorseMergeCollection {
+    GcrSimpleCollection parent;
+
+    GHashTable *keys;           /* long key ID → key */
+    GHashTable *merged;         /* The keys made for merging into */
+};
+
+struct _SeahorseMergeCollectionClass {
+    GcrSimpleCollectionClass parent_class;
+};
+
+G_DEFINE_TYPE (SeahorseMergeCollection, seahorse_merge_collection, GCR_TYPE_SIMPLE_COLLECTION);
+
+/* Key servers don't agree on case or spacing of fingerprints, and LDAP
+ * servers only have a key ID to calculate one from. So keys are matched
+ * on their long key ID: the last 16 digits of either. Keys with only a
+ * short key ID aren't merged at all. */
+static char *
+calc_merge_id (const char *fingerprint)
+{
+    g_autofree char *digits = NULL;
+    size_t n;
+
+    if (fingerprint == NULL)
+        return NULL;
+
+    digits = seahorse_pgp_subkey_normalize_fingerprint (fingerprint);
+    n = strlen (digits);
+    if (n < 16)
+        return NULL;
+    return g_strdup (digits + n - 16);
+}
+
+static gboolean
+has_uid (SeahorsePgpKey *key,
+         SeahorsePgpUid *uid)
+{
+    GListModel *uids = seahorse_pgp_key_get_uids (key);
+
+    for (guint i = 0; i < g_list_model_get_n_items (uids); i++) {
+        g_autoptr(SeahorsePgpUid) other = g_list_model_get_item (uids, i);
+
+        if (g_strcmp0 (seahorse_pgp_uid_get_name (uid), seahorse_pgp_uid_get_name (other)) == 0 &&
+            g_strcmp0 (seahorse_pgp_uid_get_email (uid), seahorse_pgp_uid_get_email (other)) == 0 &&
+            g_strcmp0 (seahorse_pgp_uid_get_comment (uid), seahorse_pgp_uid_get_comment (other)) == 0)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static gboolean
+has_subkey (SeahorsePgpKey    *key,
+            SeahorsePgpSubkey *subkey)
+{
+    GListModel *subkeys = seahorse_pgp_key_get_subkeys (key);
+    const char *keyid = seahorse_pgp_subkey_get_keyid (subkey);
+
+    /* Can't be told apart, so don't bother */
+    if (keyid == NULL)
+        return TRUE;
+
+    for (guint i = 0; i < g_list_model_get_n_items (subkeys); i++) {
+        g_autoptr(SeahorsePgpSubkey) other = g_list_model_get_item (subkeys, i);
+        const char *other_keyid = seahorse_pgp_subkey_get_keyid (other);
+
+        if (other_keyid && g_ascii_strcasecmp (keyid, other_keyid) == 0)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* @into gets copies of the UIDs and subkeys of @from, which stay with
+ * @from. Call seahorse_pgp_key_realize() on @into afterwards. */
+static void
+merge_key (SeahorsePgpKey *into,
+           SeahorsePgpKey *from)
+{
+    GListModel *uids = seahorse_pgp_key_get_uids (from);
+    GListModel *subkeys = seahorse_pgp_key_get_subkeys (from);
+    guint into_flags = 0, from_flags = 0;
+
+    /* One server knowing about a revocation is enough */
+    g_object_get (into, "object-flags", &into_flags, NULL);
+    g_object_get (from, "object-flags", &from_flags, NULL);
+    into_flags |= from_flags & (SEAHORSE_FLAG_REVOKED | SEAHORSE_FLAG_DISABLED);
+    g_object_set (into, "object-flags", into_flags, NULL);
+
+    for (guint i = 0; i < g_list_model_get_n_items (uids); i++) {
+        g_autoptr(SeahorsePgpUid) uid = g_list_model_get_item (uids, i);
+        g_autoptr(SeahorsePgpUid) copy = NULL;
+
+        if (has_uid (into, uid))
+            continue;
+
+        copy = seahorse_pgp_uid_new (into, NULL);
+        seahorse_pgp_uid_set_name (copy, seahorse_pgp_uid_get_name (uid));
+        seahorse_pgp_uid_set_email (copy, seahorse_pgp_uid_get_email (uid));
+        seahorse_pgp_uid_set_comment (copy, seahorse_pgp_uid_get_comment (uid));
+        seahorse_pgp_uid_set_validity (copy, seahorse_pgp_uid_get_validity (uid));
+        seahorse_pgp_key_add_uid (into, copy);
+    }
+
+    for (guint i = 0; i < g_list_model_get_n_items (subkeys); i++) {
+        g_autoptr(SeahorsePgpSubkey) subkey = g_list_model_get_item (subkeys, i);
+        g_autoptr(SeahorsePgpSubkey) copy = NULL;
+
+        if (has_subkey (into, subkey))
+            continue;
+
+        copy = seahorse_pgp_subkey_new ();
+        seahorse_pgp_subkey_set_index (copy, g_list_model_get_n_items (seahorse_pgp_key_get_subkeys (into)));
+        seahorse_pgp_subkey_set_keyid (copy, seahorse_pgp_subkey_get_keyid (subkey));
+        seahorse_pgp_subkey_set_fingerprint (copy, seahorse_pgp_subkey_get_fingerprint (subkey));
+        seahorse_pgp_subkey_set_algorithm (copy, seahorse_pgp_subkey_get_algorithm (subkey));
+        seahorse_pgp_subkey_set_length (copy, seahorse_pgp_subkey_get_length (subkey));
+        seahorse_pgp_subkey_set_flags (copy, seahorse_pgp_subkey_get_flags (subkey));
+        seahorse_pgp_subkey_set_created (copy, seahorse_pgp_subkey_get_created (subkey));
+        seahorse_pgp_subkey_set_expires (copy, seahorse_pgp_subkey_get_expires (subkey));
+        seahorse_pgp_subkey_set_description (copy, seahorse_pgp_subkey_get_description (subkey));
+        seahorse_pgp_key_add_subkey (into, copy);
+    }
+}
+
+/* The keys that are added belong to the server source that found them, and
+ * may be shown elsewhere too (eg. from the search cache). So once a second
+ * server has something to add, @key is replaced with a key of our own. */
+static SeahorsePgpKey *
+replace_with_copy (SeahorseMergeCollection *self,
+                   const char              *merge_id,
+                   SeahorsePgpKey          *key)
+{
+    g_autoptr(SeahorsePgpKey) copy = NULL;
+    guint flags = 0;
+
+    g_object_get (key, "object-flags", &flags, NULL);
+    copy = seahorse_pgp_key_new ();
+    g_object_set (copy,
+                  "object-flags", flags,
+                  "place", seahorse_object_get_place (SEAHORSE_OBJECT (key)),
+                  NULL);
+    merge_key (copy, key);
+
+    gcr_simple_collection_remove (GCR_SIMPLE_COLLECTION (self), G_OBJECT (key));
+    g_hash_table_insert (self->keys, g_strdup (merge_id), copy);
+    g_hash_table_add (self->merged, copy);
+    gcr_simple_collection_add (GCR_SIMPLE_COLLECTION (self), G_OBJECT (copy));
+
+    return copy;
+}
+
+static void
+on_removed (GcrCollection *collection,
+            GObject       *object,
+            gpointer       user_data)
+{
+    SeahorseMergeCollection *self = SEAHORSE_MERGE_COLLECTION (collection);
+    g_autofree char *merge_id = NULL;
+
+    if (!SEAHORSE_PGP_IS_KEY (object))
+        return;
+
+    g_hash_table_remove (self->merged, object);
+
+    merge_id = calc_merge_id (seahorse_pgp_key_get_fingerprint (SEAHORSE_PGP_KEY (object)));
+    if (merge_id && g_hash_table_lookup (self->keys, merge_id) == object)
+        g_hash_table_remove (self->keys, merge_id);
+}
+
+static void
+seahorse_merge_collection_init (SeahorseMergeCollection *self)
+{
+    /* The keys are owned by the collection */
+    self->keys = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    self->merged = g_hash_table_new (g_direct_hash, g_direct_equal);
+    g_signal_connect (self, "removed", G_CALLBACK (on_removed), NULL);
+}
+
+static void
+seahorse_merge_collection_finalize (GObject *obj)
+{
+    SeahorseMergeCollection *self = SEAHORSE_MERGE_COLLECTION (obj);
+
+    g_hash_table_unref (self->keys);
+    g_hash_table_unref (self->merged);
+
+    G_OBJECT_CLASS (seahorse_merge_collection_parent_class)->finalize (obj);
+}
+
+static void
+seahorse_merge_collection_class_init (SeahorseMergeCollectionClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->finalize = seahorse_merge_collection_finalize;
+}
+
+/**
+ * seahorse_merge_collection_new:
+ *
+ * Returns: (transfer full): A new, empty collection
+ */
+GcrSimpleCollection *
+seahorse_merge_collection_new (void)
+{
+    return g_object_new (SEAHORSE_TYPE_MERGE_COLLECTION, NULL);
+}
+
+/**
+ * seahorse_merge_collection_add_key:
+ * @self: A #SeahorseMergeCollection
+ * @key: The key to add
+ *
+ * Adds @key to the collection. If a key with the same long key ID is
+ * already in there, the UIDs and subkeys of @key are merged in. @key itself
+ * and the key that's already in there are left untouched: the collection
+ * then holds a merged key of its own.
+ *
+ * Returns: (transfer none): The key in the collection that represents @key
+ */
+SeahorsePgpKey *
+seahorse_merge_collection_add_key (SeahorseMergeCollection *self,
+                                   SeahorsePgpKey          *key)
+{
+    g_autofree char *merge_id = NULL;
+    SeahorsePgpKey *existing;
+
+    g_return_val_if_fail (SEAHORSE_IS_MERGE_COLLECTION (self), NULL);
+    g_return_val_if_fail (SEAHORSE_PGP_IS_KEY (key), NULL);
+
+    merge_id = calc_merge_id (seahorse_pgp_key_get_fingerprint (key));
+
+    /* Without a long key ID, there's nothing to merge on */
+    if (merge_id == NULL) {
+        gcr_simple_collection_add (GCR_SIMPLE_COLLECTION (self), G_OBJECT (key));
+        return key;
+    }
+
+    existing = g_hash_table_lookup (self->keys, merge_id);
+    if (existing == key)
+        return key;
+
+    if (existing != NULL) {
+        if (!g_hash_table_contains (self->merged, existing))
+            existing = replace_with_copy (self, merge_id, existing);
+        merge_key (existing, key);
+        seahorse_pgp_key_realize (existing);
+        return existing;
+    }
+
+    g_hash_table_insert (self->keys, g_steal_pointer (&merge_id), key);
+    gcr_simple_collection_add (GCR_SIMPLE_COLLECTION (self), G_OBJECT (key));
+    return key;
+}
+
+/**
+ * seahorse_merge_collection_lookup:
+ * @self: A #SeahorseMergeCollection
+ * @fingerprint: The fingerprint or long key ID, in any case or spacing
+ *
+ * Returns: (transfer none) (nullable): The key with @fingerprint
+ */
+SeahorsePgpKey *
+seahorse_merge_collection_lookup (SeahorseMergeCollection *self,
+                                  const char              *fingerprint)
+{
+    g_autofree char *merge_id = NULL;
+
+    g_return_val_if_fail (SEAHORSE_IS_MERGE_COLLECTION (self), NULL);
+    g_return_val_if_fail (fingerprint != NULL, NULL);
+
+    merge_id = calc_merge_id (fingerprint);
+    if (merge_id == NULL)
+        return NULL;
+    return g_hash_table_lookup (self->keys, merge_id);
+}
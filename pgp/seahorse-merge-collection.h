@@ -0,0 +1,51 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SeahorseMergeCollection: A collection of PGP keys, unique by fingerprint
+ *
+ * - Used for the results of searching several key servers.
+ * - A key that's already in the collection (by long key ID, so also between
+ *   HKP and LDAP servers) isn't added again; its UIDs and subkeys are merged
+ *   into a key that the collection makes for that, leaving the keys of the
+ *   servers (and their search cache) untouched.
+ */
+
+#pragma once
+
+#include <gcr/gcr.h>
+
+#include "seahorse-pgp-key.h"
+
+#define SEAHORSE_TYPE_MERGE_COLLECTION     (seahorse_merge_collection_get_type ())
+#define SEAHORSE_MERGE_COLLECTION(obj)     (G_TYPE_CHECK_INSTANCE_CAST ((obj), SEAHORSE_TYPE_MERGE_COLLECTION, SeahorseMergeCollection))
+#define SEAHORSE_IS_MERGE_COLLECTION(obj)  (G_TYPE_CHECK_INSTANCE_TYPE ((obj), SEAHORSE_TYPE_MERGE_COLLECTION))
+
+typedef struct _SeahorseMergeCollection SeahorseMergeCollection;
+typedef struct _SeahorseMergeCollectionClass SeahorseMergeCollectionClass;
+
+GType                     seahorse_merge_collection_get_type (void) G_GNUC_CONST;
+
+GcrSimpleCollection *     seahorse_merge_collection_new      (void);
+
+SeahorsePgpKey *          seahorse_merge_collection_add_key  (SeahorseMergeCollection *self,
+                                                              SeahorsePgpKey          *key);
+
+SeahorsePgpKey *          seahorse_merge_collection_lookup   (SeahorseMergeCollection *self,
+                                                              const char              *fingerprint);
@@ -20,9 +20,14 @@
 
 #include "config.h"
 
+#include "seahorse-discovery-cache.h"
 #include "seahorse-gpgme-dialogs.h"
+#include "seahorse-hkp-source.h"
+#include "seahorse-keyserver-refresh.h"
+#include "seahorse-merge-collection.h"
 #include "seahorse-pgp-actions.h"
 #include "seahorse-pgp-backend.h"
+#include "seahorse-search-cache.h"
 #include "seahorse-server-source.h"
 #include "seahorse-transfer.h"
 #include "seahorse-unknown-source.h"
@@ -36,6 +41,20 @@
 
 #include <string.h>
 
+/* Limits of the cache of key server search results */
+#define SEARCH_CACHE_MAX_ENTRIES 64
+#define SEARCH_CACHE_MAX_SIZE    (4 * 1024 * 1024)
+#define SEARCH_CACHE_TTL         (10 * G_TIME_SPAN_MINUTE)
+
+/* Seconds after which a key server search is abandoned, and milliseconds
+ * after which a second request is sent to a server that didn't answer yet */
+#define SEARCH_SERVER_DEADLINE    20
+#define SEARCH_SERVER_HEDGE_DELAY 3000
+
+/* How long to remember whether a key server had a key we discovered */
+#define DISCOVERY_FOUND_TTL      (7 * G_TIME_SPAN_DAY)
+#define DISCOVERY_MISSING_TTL    (G_TIME_SPAN_DAY)
+
 static SeahorsePgpBackend *pgp_backend = NULL;
 
 struct _SeahorsePgpBackend {
@@ -48,6 +67,10 @@ struct _SeahorsePgpBackend {
     SeahorseDiscovery *discovery;
     SeahorseUnknownSource *unknown;
     GListModel *remotes;
+    SeahorseSearchCache *search_cache;
+    SeahorseDiscoveryCache *discovery_cache;
+    SeahorseKeyserverRefresh *refresh;
+    gboolean refresh_started;
     SeahorseActionGroup *actions;
     gboolean loaded;
 };
@@ -83,6 +106,9 @@ seahorse_pgp_backend_init (SeahorsePgpBackend *self)
 
     self->pgp_settings = seahorse_pgp_settings_instance ();
     self->remotes = G_LIST_MODEL (g_list_store_new (SEAHORSE_TYPE_SERVER_SOURCE));
+    self->search_cache = seahorse_search_cache_new (SEARCH_CACHE_MAX_ENTRIES,
+                                                    SEARCH_CACHE_MAX_SIZE,
+                                                    SEARCH_CACHE_TTL);
     self->actions = seahorse_pgp_backend_actions_instance ();
 }
 
@@ -133,6 +159,22 @@ on_settings_keyservers_changed (GSettings  *settings,
     }
 }
 
+static void
+on_settings_refresh_changed (GSettings  *settings,
+                             const char *key,
+                             gpointer    user_data)
+{
+    SeahorsePgpBackend *self = SEAHORSE_PGP_BACKEND (user_data);
+    SeahorseAppSettings *app_settings = SEAHORSE_APP_SETTINGS (settings);
+
+    if (seahorse_app_settings_get_server_auto_refresh (app_settings)) {
+        guint period = seahorse_app_settings_get_server_refresh_period (app_settings);
+        seahorse_keyserver_refresh_start (self->refresh, period);
+    } else {
+        seahorse_keyserver_refresh_stop (self->refresh);
+    }
+}
+
 #endif /* WITH_KEYSERVER */
 
 static void
@@ -176,6 +218,26 @@ seahorse_pgp_backend_constructed (GObject *obj)
     self->unknown = seahorse_unknown_source_new ();
 
 #ifdef WITH_KEYSERVER
+    {
+        g_autofree char *filename = NULL;
+
+        filename = g_build_filename (g_get_user_cache_dir (), "seahorse",
+                                     "discovery-cache.ini", NULL);
+        self->discovery_cache = seahorse_discovery_cache_new (filename,
+                                                              DISCOVERY_FOUND_TTL,
+                                                              DISCOVERY_MISSING_TTL);
+    }
+
+    {
+        g_autofree char *filename = NULL;
+
+        filename = g_build_filename (g_get_user_cache_dir (), "seahorse",
+                                     "refresh-state.ini", NULL);
+        self->refresh = seahorse_keyserver_refresh_new (self->keyring,
+                                                        self->remotes,
+                                                        filename);
+    }
+
     g_signal_connect (self->pgp_settings, "changed::keyservers",
                       G_CALLBACK (on_settings_keyservers_changed), self);
 
@@ -288,6 +350,10 @@ seahorse_pgp_backend_finalize (GObject *obj)
 #ifdef WITH_KEYSERVER
     g_signal_handlers_disconnect_by_func (self->pgp_settings,
                                           on_settings_keyservers_changed, self);
+    if (self->refresh_started)
+        g_signal_handlers_disconnect_by_func (seahorse_app_settings_instance (),
+                                              on_settings_refresh_changed, self);
+    seahorse_keyserver_refresh_stop (self->refresh);
 #endif
 
     g_clear_pointer (&self->gpg_homedir, g_free);
@@ -295,6 +361,9 @@ seahorse_pgp_backend_finalize (GObject *obj)
     g_clear_object (&self->discovery);
     g_clear_object (&self->unknown);
     g_clear_object (&self->remotes);
+    g_clear_object (&self->search_cache);
+    g_clear_object (&self->discovery_cache);
+    g_clear_object (&self->refresh);
     g_clear_object (&self->actions);
     pgp_backend = NULL;
 
@@ -441,6 +510,35 @@ seahorse_pgp_backend_get_default_key (SeahorsePgpBackend *self)
     return key;
 }
 
+/**
+ * seahorse_pgp_backend_start_background_refresh:
+ * @self: (nullable): The PGP backend, or %NULL for the default one
+ *
+ * Refreshes the keys in the keyring from the key servers in the background,
+ * for as long as the "server-auto-refresh" setting is enabled. This is left
+ * to the application, so the backend can be used without its settings.
+ */
+void
+seahorse_pgp_backend_start_background_refresh (SeahorsePgpBackend *self)
+{
+    self = self ? self : seahorse_pgp_backend_get ();
+    g_return_if_fail (SEAHORSE_PGP_IS_BACKEND (self));
+
+#ifdef WITH_KEYSERVER
+    if (self->refresh_started)
+        return;
+    self->refresh_started = TRUE;
+
+    g_signal_connect (seahorse_app_settings_instance (), "changed::server-auto-refresh",
+                      G_CALLBACK (on_settings_refresh_changed), self);
+    g_signal_connect (seahorse_app_settings_instance (), "changed::server-refresh-period",
+                      G_CALLBACK (on_settings_refresh_changed), self);
+    on_settings_refresh_changed (G_SETTINGS (seahorse_app_settings_instance ()),
+                                 "server-auto-refresh",
+                                 self);
+#endif
+}
+
 #ifdef WITH_KEYSERVER
 
 SeahorseDiscovery *
@@ -507,8 +605,17 @@ seahorse_pgp_backend_add_remote (SeahorsePgpBackend   *self,
         ssrc = seahorse_server_category_create_server (uri);
         /* If the scheme of the uri is ldap, but ldap support is disabled
          * in the build, ssrc will be NULL. */
-        if (ssrc)
-            g_list_store_append (G_LIST_STORE (self->remotes), ssrc);
+        if (!ssrc)
+            return;
+
+#ifdef WITH_HKP
+        /* Refreshing keys we have only downloads the ones that changed */
+        if (SEAHORSE_IS_HKP_SOURCE (ssrc))
+            seahorse_hkp_source_set_known_keys (SEAHORSE_HKP_SOURCE (ssrc),
+                                                GCR_COLLECTION (self->keyring));
+#endif
+
+        g_list_store_append (G_LIST_STORE (self->remotes), ssrc);
     }
 }
 
@@ -538,38 +645,306 @@ seahorse_pgp_backend_remove_remote (SeahorsePgpBackend *self,
 
 typedef struct {
     int num_searches;
+    int num_succeeded;
+    GError *error;                  /* The first failure of any server */
+    GHashTable *fingerprints;       /* Of the keys added to the results */
 } search_remote_closure;
 
 static void
 search_remote_closure_free (gpointer user_data)
 {
     search_remote_closure *closure = user_data;
+    g_clear_error (&closure->error);
+    g_hash_table_unref (closure->fingerprints);
     g_free (closure);
 }
 
+/* Adds a key to the results, unless another server already returned it.
+ * A merge collection does this itself, merging in what the key adds. */
+static void
+search_remote_add_result (search_remote_closure *closure,
+                          GcrSimpleCollection   *results,
+                          GObject               *object)
+{
+    const char *fingerprint;
+
+    if (SEAHORSE_IS_MERGE_COLLECTION (results)) {
+        seahorse_merge_collection_add_key (SEAHORSE_MERGE_COLLECTION (results),
+                                           SEAHORSE_PGP_KEY (object));
+        return;
+    }
+
+    fingerprint = seahorse_pgp_key_get_fingerprint (SEAHORSE_PGP_KEY (object));
+    if (fingerprint && *fingerprint &&
+        !g_hash_table_add (closure->fingerprints, g_ascii_strup (fingerprint, -1)))
+        return;
+
+    gcr_simple_collection_add (results, object);
+}
+
+/* The search on a single server. Results are collected separately, so they
+ * can be cached per server, and forwarded to the caller as they come in.
+ *
+ * The search is abandoned after a deadline, so a slow server doesn't hold up
+ * the others. When a server is slow to answer, a second (hedged) request is
+ * sent, which for pools (eg. DNS round robin) likely ends up at another
+ * mirror. The first one to answer wins. */
+typedef struct {
+    int refs;
+    SeahorsePgpBackend *backend;
+    SeahorseServerSource *source;
+    GTask *task;                    /* NULL for a background refresh */
+    char *uri;
+    char *search;
+    GcrSimpleCollection *results;
+    GCancellable *cancellable;      /* Cancels all attempts on this server */
+    gulong cancelled_sig;
+    guint deadline_id;
+    guint hedge_id;
+    int num_attempts;
+    gboolean timed_out;
+    gboolean done;
+} search_server_closure;
+
+/* A single request to a server */
+typedef struct {
+    search_server_closure *server;
+    GcrSimpleCollection *found;
+} search_attempt_closure;
+
+static search_server_closure *
+search_server_closure_ref (search_server_closure *server)
+{
+    server->refs++;
+    return server;
+}
+
+static void
+search_server_closure_unref (search_server_closure *server)
+{
+    if (--server->refs > 0)
+        return;
+
+    g_assert (server->deadline_id == 0);
+    g_assert (server->hedge_id == 0);
+
+    if (server->task)
+        g_cancellable_disconnect (g_task_get_cancellable (server->task),
+                                  server->cancelled_sig);
+    g_object_unref (server->backend);
+    g_object_unref (server->source);
+    g_clear_object (&server->task);
+    g_free (server->uri);
+    g_free (server->search);
+    g_clear_object (&server->results);
+    g_object_unref (server->cancellable);
+    g_free (server);
+}
+
+static void
+search_attempt_closure_free (search_attempt_closure *attempt)
+{
+    g_signal_handlers_disconnect_by_data (attempt->found, attempt);
+    g_object_unref (attempt->found);
+    search_server_closure_unref (attempt->server);
+    g_free (attempt);
+}
+
+static void
+on_server_search_found (GcrCollection *collection,
+                        GObject       *object,
+                        gpointer       user_data)
+{
+    search_attempt_closure *attempt = user_data;
+    search_server_closure *server = attempt->server;
+
+    if (server->done || server->results == NULL)
+        return;
+
+    search_remote_add_result (g_task_get_task_data (server->task),
+                              server->results, object);
+}
+
+static void
+search_server_complete (search_server_closure *server,
+                        GcrCollection         *found,
+                        GError                *error)
+{
+    search_remote_closure *closure;
+    g_autoptr(GList) objects = NULL;
+    g_autoptr(GPtrArray) keys = NULL;
+    GCancellable *cancellable;
+
+    g_assert (!server->done);
+    server->done = TRUE;
+
+    g_clear_handle_id (&server->deadline_id, g_source_remove);
+    g_clear_handle_id (&server->hedge_id, g_source_remove);
+
+    /* Stop any remaining (hedged) request */
+    g_cancellable_cancel (server->cancellable);
+
+    if (error == NULL) {
+        objects = gcr_collection_get_objects (found);
+        keys = g_ptr_array_new ();
+        for (GList *l = objects; l; l = g_list_next (l))
+            g_ptr_array_add (keys, l->data);
+        seahorse_search_cache_store (server->backend->search_cache,
+                                     server->uri, server->search, keys);
+    } else {
+        seahorse_search_cache_invalidate (server->backend->search_cache,
+                                          server->uri, server->search);
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_message ("Couldn't search for '%s' on %s: %s",
+                       server->search, server->uri, error->message);
+    }
+
+    if (server->task == NULL)
+        return;
+
+    closure = g_task_get_task_data (server->task);
+    g_return_if_fail (closure->num_searches > 0);
+
+    if (error == NULL)
+        closure->num_succeeded++;
+    else if (closure->error == NULL)
+        closure->error = g_error_copy (error);
+
+    closure->num_searches--;
+    cancellable = g_task_get_cancellable (server->task);
+    seahorse_progress_end (cancellable, GINT_TO_POINTER (closure->num_searches));
+
+    if (closure->num_searches > 0)
+        return;
+
+    /* Only fail if no server at all could answer */
+    if (g_task_return_error_if_cancelled (server->task))
+        return;
+    if (closure->num_succeeded == 0 && closure->error != NULL)
+        g_task_return_error (server->task, g_steal_pointer (&closure->error));
+    else
+        g_task_return_boolean (server->task, TRUE);
+}
+
 static void
 on_source_search_ready (GObject *source,
                         GAsyncResult *result,
                         gpointer user_data)
 {
-    g_autoptr(GTask) task = G_TASK (user_data);
-    search_remote_closure *closure = g_task_get_task_data (task);
+    search_attempt_closure *attempt = user_data;
+    search_server_closure *server = attempt->server;
     g_autoptr(GError) error = NULL;
 
-    g_return_if_fail (closure->num_searches > 0);
+    server->num_attempts--;
 
     if (!seahorse_server_source_search_finish (SEAHORSE_SERVER_SOURCE (source),
                                                result, &error)) {
-        g_task_return_error (task, g_steal_pointer (&error));
-        return;
+        /* Another attempt might still succeed */
+        if (!server->done && server->num_attempts == 0) {
+            if (server->timed_out) {
+                g_clear_error (&error);
+                g_set_error (&error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT,
+                             _("The key server %s didn’t respond in time"),
+                             server->uri);
+            }
+            search_server_complete (server, NULL, error);
+        }
+    } else if (!server->done) {
+        search_server_complete (server, GCR_COLLECTION (attempt->found), NULL);
     }
 
-    closure->num_searches--;
-    seahorse_progress_end (g_task_get_cancellable (task),
-                           GINT_TO_POINTER (closure->num_searches));
+    search_attempt_closure_free (attempt);
+}
 
-    if (closure->num_searches == 0)
-        g_task_return_boolean (task, TRUE);
+static void
+search_server_attempt (search_server_closure *server)
+{
+    search_attempt_closure *attempt;
+
+    attempt = g_new0 (search_attempt_closure, 1);
+    attempt->server = search_server_closure_ref (server);
+    attempt->found = GCR_SIMPLE_COLLECTION (gcr_simple_collection_new ());
+    g_signal_connect (attempt->found, "added",
+                      G_CALLBACK (on_server_search_found), attempt);
+
+    server->num_attempts++;
+    seahorse_server_source_search_async (server->source, server->search,
+                                         attempt->found, server->cancellable,
+                                         on_source_search_ready, attempt);
+}
+
+static gboolean
+on_search_server_hedge (gpointer user_data)
+{
+    search_server_closure *server = user_data;
+
+    server->hedge_id = 0;
+    if (g_cancellable_is_cancelled (server->cancellable))
+        return G_SOURCE_REMOVE;
+
+    g_debug ("No answer from %s yet, sending another request", server->uri);
+    search_server_attempt (server);
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+on_search_server_deadline (gpointer user_data)
+{
+    search_server_closure *server = user_data;
+
+    g_debug ("No answer from %s in time, giving up", server->uri);
+    server->deadline_id = 0;
+    g_clear_handle_id (&server->hedge_id, g_source_remove);
+    server->timed_out = TRUE;
+    g_cancellable_cancel (server->cancellable);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+on_search_task_cancelled (GCancellable *cancellable,
+                          gpointer      user_data)
+{
+    GCancellable *server_cancellable = user_data;
+    g_cancellable_cancel (server_cancellable);
+}
+
+static void
+search_server_start (SeahorsePgpBackend   *self,
+                     SeahorseServerSource *ssrc,
+                     const char           *uri,
+                     const char           *search,
+                     GcrSimpleCollection  *results,
+                     GTask                *task)
+{
+    search_server_closure *server;
+    GCancellable *cancellable;
+
+    server = g_new0 (search_server_closure, 1);
+    server->refs = 1;
+    server->backend = g_object_ref (self);
+    server->source = g_object_ref (ssrc);
+    server->task = task ? g_object_ref (task) : NULL;
+    server->uri = g_strdup (uri);
+    server->search = g_strdup (search);
+    server->results = results ? g_object_ref (results) : NULL;
+    server->cancellable = g_cancellable_new ();
+
+    cancellable = task ? g_task_get_cancellable (task) : NULL;
+    if (cancellable)
+        server->cancelled_sig = g_cancellable_connect (cancellable,
+                                                       G_CALLBACK (on_search_task_cancelled),
+                                                       server->cancellable, NULL);
+
+    server->deadline_id = g_timeout_add_seconds (SEARCH_SERVER_DEADLINE,
+                                                 on_search_server_deadline, server);
+
+    /* Nobody is waiting for a background refresh */
+    if (task != NULL)
+        server->hedge_id = g_timeout_add (SEARCH_SERVER_HEDGE_DELAY,
+                                          on_search_server_hedge, server);
+
+    search_server_attempt (server);
+    search_server_closure_unref (server);
 }
 
 void
@@ -584,6 +959,7 @@ seahorse_pgp_backend_search_remote_async (SeahorsePgpBackend *self,
     g_autoptr(GTask) task = NULL;
     g_autoptr(GHashTable) servers = NULL;
     g_auto(GStrv) names = NULL;
+    gboolean searched = FALSE;
 
     self = self ? self : seahorse_pgp_backend_get ();
     g_return_if_fail (SEAHORSE_PGP_IS_BACKEND (self));
@@ -598,27 +974,43 @@ seahorse_pgp_backend_search_remote_async (SeahorsePgpBackend *self,
 
     task = g_task_new (self, cancellable, callback, user_data);
     closure = g_new0 (search_remote_closure, 1);
+    closure->fingerprints = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
     g_task_set_task_data (task, closure, search_remote_closure_free);
 
     for (guint i = 0; i < g_list_model_get_n_items (self->remotes); i++) {
         g_autoptr(SeahorseServerSource) ssrc = NULL;
+        g_autofree char *src_uri = NULL;
+        g_autoptr(GPtrArray) cached = NULL;
+        gboolean refresh;
 
         ssrc = g_list_model_get_item (self->remotes, i);
-        if (servers) {
-            g_autofree char *src_uri = NULL;
-            src_uri = seahorse_place_get_uri (SEAHORSE_PLACE (ssrc));
-            if (!g_hash_table_lookup (servers, src_uri))
-                continue;
+        src_uri = seahorse_place_get_uri (SEAHORSE_PLACE (ssrc));
+        if (servers && !g_hash_table_lookup (servers, src_uri))
+            continue;
+
+        searched = TRUE;
+
+        /* Serve repeated searches from the cache, refreshing it in the
+         * background once the entry gets older */
+        cached = seahorse_search_cache_lookup (self->search_cache,
+                                               src_uri, search, &refresh);
+        if (cached != NULL) {
+            g_debug ("Found %u cached results for '%s' on %s",
+                     cached->len, search, src_uri);
+            for (guint j = 0; j < cached->len; j++)
+                search_remote_add_result (closure, results, g_ptr_array_index (cached, j));
+            if (refresh)
+                search_server_start (self, ssrc, src_uri, search, NULL, NULL);
+            continue;
         }
 
         seahorse_progress_prep_and_begin (cancellable, GINT_TO_POINTER (closure->num_searches), NULL);
-        seahorse_server_source_search_async (ssrc, search, results, cancellable,
-                                             on_source_search_ready, g_object_ref (task));
         closure->num_searches++;
+        search_server_start (self, ssrc, src_uri, search, results, task);
     }
 
     if (closure->num_searches == 0)
-        g_task_return_boolean (task, FALSE);
+        g_task_return_boolean (task, searched);
 }
 
 gboolean
@@ -779,6 +1171,155 @@ seahorse_pgp_backend_retrieve_finish (SeahorsePgpBackend *self,
     return g_task_propagate_boolean (G_TASK (result), error);
 }
 
+/* Signers are discovered every time a UID gets expanded, so we remember
+ * what each key server had (or didn't have), also across sessions */
+typedef struct {
+    SeahorsePgpBackend *backend;
+    char *uri;
+    GStrv keyids;
+    GCancellable *cancellable;
+} discover_closure;
+
+static void
+discover_closure_free (discover_closure *closure)
+{
+    g_object_unref (closure->backend);
+    g_free (closure->uri);
+    g_strfreev (closure->keyids);
+    g_clear_object (&closure->cancellable);
+    g_free (closure);
+}
+
+/* Transfers to all servers run at the same time, so whether a server had
+ * a key is decided from what it sent itself, not from the keyring */
+static void
+discover_record (discover_closure *closure,
+                 GList *keys)
+{
+    SeahorsePgpBackend *self = closure->backend;
+    g_autoptr(GError) error = NULL;
+
+    for (guint i = 0; closure->keyids[i] != NULL; i++) {
+        const char *keyid = closure->keyids[i];
+        gboolean found = FALSE;
+
+        for (GList *l = keys; l != NULL && !found; l = g_list_next (l))
+            found = seahorse_pgp_key_has_keyid (SEAHORSE_PGP_KEY (l->data), keyid);
+
+        seahorse_discovery_cache_record (self->discovery_cache,
+                                         closure->uri, keyid, found);
+    }
+
+    if (!seahorse_discovery_cache_save (self->discovery_cache, &error))
+        g_message ("Couldn't save key discovery cache: %s", error->message);
+}
+
+static void
+on_discover_import_ready (GObject *source,
+                          GAsyncResult *result,
+                          gpointer user_data)
+{
+    discover_closure *closure = user_data;
+    g_autoptr(GError) error = NULL;
+    g_autoptr(GList) keys = NULL;
+
+    keys = seahorse_gpgme_keyring_import_finish (SEAHORSE_GPGME_KEYRING (source),
+                                                 result, &error);
+
+    /* Don't remember anything if the keys couldn't be imported */
+    if (error != NULL) {
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_message ("Couldn't import keys discovered on %s: %s",
+                       closure->uri, error->message);
+        discover_closure_free (closure);
+        return;
+    }
+
+    discover_record (closure, keys);
+    discover_closure_free (closure);
+}
+
+static void
+on_discover_export_ready (GObject *source,
+                          GAsyncResult *result,
+                          gpointer user_data)
+{
+    discover_closure *closure = user_data;
+    SeahorsePgpBackend *self = closure->backend;
+    g_autoptr(GError) error = NULL;
+    g_autoptr(GInputStream) input = NULL;
+    gpointer data;
+    gsize size = 0;
+
+    data = seahorse_server_source_export_finish (SEAHORSE_SERVER_SOURCE (source),
+                                                 result, &size, &error);
+
+    /* Don't remember anything if the server couldn't be asked */
+    if (error != NULL) {
+        if (!g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_message ("Couldn't discover keys on %s: %s",
+                       closure->uri, error->message);
+        g_free (data);
+        discover_closure_free (closure);
+        return;
+    }
+
+    /* The server had none of them */
+    if (size == 0) {
+        g_free (data);
+        discover_record (closure, NULL);
+        discover_closure_free (closure);
+        return;
+    }
+
+    input = g_memory_input_stream_new_from_data (data, size, g_free);
+    seahorse_gpgme_keyring_import_async (self->keyring, input, closure->cancellable,
+                                         on_discover_import_ready, closure);
+}
+
+static void
+discover_remote_keys (SeahorsePgpBackend *self,
+                      const char **keyids,
+                      GCancellable *cancellable)
+{
+    for (guint i = 0; i < g_list_model_get_n_items (self->remotes); i++) {
+        g_autoptr(SeahorseServerSource) ssrc = NULL;
+        g_autoptr(GPtrArray) unknown = NULL;
+        discover_closure *closure;
+
+        ssrc = g_list_model_get_item (self->remotes, i);
+
+        closure = g_new0 (discover_closure, 1);
+        closure->backend = g_object_ref (self);
+        closure->uri = seahorse_place_get_uri (SEAHORSE_PLACE (ssrc));
+        if (cancellable != NULL)
+            closure->cancellable = g_object_ref (cancellable);
+
+        /* Only ask for the keys we don't know about on this server */
+        unknown = g_ptr_array_new_with_free_func (g_free);
+        for (guint j = 0; keyids[j] != NULL; j++) {
+            SeahorseDiscoveryState state;
+
+            state = seahorse_discovery_cache_lookup (self->discovery_cache,
+                                                     closure->uri, keyids[j]);
+            if (state == SEAHORSE_DISCOVERY_UNKNOWN)
+                g_ptr_array_add (unknown, g_strdup (keyids[j]));
+        }
+
+        if (unknown->len == 0) {
+            g_debug ("All keys already discovered on %s", closure->uri);
+            discover_closure_free (closure);
+            continue;
+        }
+
+        g_ptr_array_add (unknown, NULL);
+        closure->keyids = (GStrv) g_ptr_array_free (g_steal_pointer (&unknown), FALSE);
+        seahorse_server_source_export_async (ssrc, (const char **) closure->keyids,
+                                             cancellable,
+                                             on_discover_export_ready, closure);
+    }
+}
+
 #endif /* WITH_KEYSERVER */
 
 GList *
@@ -821,8 +1362,7 @@ seahorse_pgp_backend_discover_keys (SeahorsePgpBackend *self,
 #ifdef WITH_KEYSERVER
         /* Start a discover process on all todiscover */
         if (seahorse_app_settings_get_server_auto_retrieve (seahorse_app_settings_instance ()))
-            seahorse_pgp_backend_retrieve_async (self, keyids, SEAHORSE_PLACE (self->keyring),
-                                                 cancellable, NULL, NULL);
+            discover_remote_keys (self, keyids, cancellable);
 #endif
 
         /* Add unknown objects for all these */
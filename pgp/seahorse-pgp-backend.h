@@ -51,6 +51,8 @@ SeahorseGpgmeKeyring * seahorse_pgp_backend_get_default_keyring  (SeahorsePgpBac
 
 SeahorsePgpKey *       seahorse_pgp_backend_get_default_key      (SeahorsePgpBackend *self);
 
+void                   seahorse_pgp_backend_start_background_refresh (SeahorsePgpBackend *self);
+
 #ifdef WITH_KEYSERVER
 
 SeahorseDiscovery *    seahorse_pgp_backend_get_discovery        (SeahorsePgpBackend *self);
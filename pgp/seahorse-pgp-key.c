@@ -49,6 +49,7 @@ enum {
 static GParamSpec *obj_props[N_PROPS] = { NULL, };
 
 static void        seahorse_pgp_key_viewable_iface          (SeahorseViewableIface *iface);
+static void        seahorse_pgp_key_searchable_iface        (SeahorseSearchableIface *iface);
 
 typedef struct _SeahorsePgpKeyPrivate {
     char *keyid;
@@ -60,6 +61,7 @@ typedef struct _SeahorsePgpKeyPrivate {
 G_DEFINE_TYPE_WITH_CODE (SeahorsePgpKey, seahorse_pgp_key, SEAHORSE_TYPE_OBJECT,
                          G_ADD_PRIVATE (SeahorsePgpKey)
                          G_IMPLEMENT_INTERFACE (SEAHORSE_TYPE_VIEWABLE, seahorse_pgp_key_viewable_iface);
+                         G_IMPLEMENT_INTERFACE (SEAHORSE_TYPE_SEARCHABLE, seahorse_pgp_key_searchable_iface);
 );
 
 /*
@@ -289,6 +291,93 @@ seahorse_pgp_key_viewable_iface (SeahorseViewableIface *iface)
     iface->create_viewer = seahorse_pgp_key_create_viewer;
 }
 
+static char *
+seahorse_pgp_key_get_search_text (SeahorseSearchable *searchable)
+{
+    SeahorsePgpKey *self = SEAHORSE_PGP_KEY (searchable);
+    SeahorsePgpKeyPrivate *priv = seahorse_pgp_key_get_instance_private (self);
+    GString *text;
+    const char *fingerprint;
+
+    text = g_string_new ("");
+
+    /* All user ids, not just the primary one that's in the label */
+    for (guint i = 0; i < g_list_model_get_n_items (priv->uids); i++) {
+        g_autoptr(SeahorsePgpUid) uid = g_list_model_get_item (priv->uids, i);
+        const char *name = seahorse_pgp_uid_get_name (uid);
+        const char *email = seahorse_pgp_uid_get_email (uid);
+
+        if (name && *name)
+            g_string_append_printf (text, "%s\n", name);
+        if (email && *email)
+            g_string_append_printf (text, "%s\n", email);
+    }
+
+    for (guint i = 0; i < g_list_model_get_n_items (priv->subkeys); i++) {
+        g_autoptr(SeahorsePgpSubkey) subkey = g_list_model_get_item (priv->subkeys, i);
+        const char *keyid = seahorse_pgp_subkey_get_keyid (subkey);
+
+        if (keyid)
+            g_string_append_printf (text, "%s\n", keyid);
+    }
+
+    /* Without the spaces, like it's usually copied from elsewhere */
+    fingerprint = seahorse_pgp_key_get_fingerprint (self);
+    for (const char *c = fingerprint; c && *c; c++) {
+        if (!g_ascii_isspace (*c))
+            g_string_append_c (text, *c);
+    }
+
+    return g_string_free (text, FALSE);
+}
+
+static char **
+seahorse_pgp_key_get_search_field (SeahorseSearchable *searchable,
+                                   const char         *field)
+{
+    SeahorsePgpKey *self = SEAHORSE_PGP_KEY (searchable);
+    SeahorsePgpKeyPrivate *priv = seahorse_pgp_key_get_instance_private (self);
+    GPtrArray *values;
+
+    values = g_ptr_array_new ();
+
+    if (g_str_equal (field, "email")) {
+        for (guint i = 0; i < g_list_model_get_n_items (priv->uids); i++) {
+            g_autoptr(SeahorsePgpUid) uid = g_list_model_get_item (priv->uids, i);
+            const char *email = seahorse_pgp_uid_get_email (uid);
+
+            if (email && *email)
+                g_ptr_array_add (values, g_strdup (email));
+        }
+    } else if (g_str_equal (field, "keyid") || g_str_equal (field, "fpr")) {
+        gboolean keyids = g_str_equal (field, "keyid");
+
+        for (guint i = 0; i < g_list_model_get_n_items (priv->subkeys); i++) {
+            g_autoptr(SeahorsePgpSubkey) subkey = g_list_model_get_item (priv->subkeys, i);
+            const char *value = keyids ? seahorse_pgp_subkey_get_keyid (subkey)
+                                       : seahorse_pgp_subkey_get_fingerprint (subkey);
+
+            if (value && *value)
+                g_ptr_array_add (values, g_strdup (value));
+        }
+    } else if (g_str_equal (field, "type")) {
+        g_ptr_array_add (values, g_strdup ("pgp"));
+    } else {
+        g_ptr_array_free (values, TRUE);
+        return NULL;
+    }
+
+    g_ptr_array_add (values, NULL);
+    return (char **) g_ptr_array_free (values, FALSE);
+}
+
+static void
+seahorse_pgp_key_searchable_iface (SeahorseSearchableIface *iface)
+{
+    iface->get_search_text = seahorse_pgp_key_get_search_text;
+    iface->get_search_field = seahorse_pgp_key_get_search_field;
+}
+
 const char*
 seahorse_pgp_key_calc_identifier (const char *keyid)
 {
@@ -450,6 +450,26 @@ seahorse_pgp_subkey_calc_fingerprint (const char *raw_fingerprint)
     return fpr;
 }
 
+/* Keeps only the hexadecimal digits, in uppercase. Key servers and the
+ * formatted fingerprints of keys don't agree on case or spacing, so this is
+ * what fingerprints are compared (and stored) as.
+ */
+char *
+seahorse_pgp_subkey_normalize_fingerprint (const char *fingerprint)
+{
+    GString *result;
+
+    g_return_val_if_fail (fingerprint != NULL, NULL);
+
+    result = g_string_sized_new (40);
+    for (const char *p = fingerprint; *p; p++) {
+        if (g_ascii_isxdigit (*p))
+            g_string_append_c (result, g_ascii_toupper (*p));
+    }
+
+    return g_string_free (result, FALSE);
+}
+
 static void
 seahorse_pgp_subkey_get_property (GObject      *object,
                                   unsigned int  prop_id,
@@ -94,3 +94,5 @@ void                seahorse_pgp_subkey_set_fingerprint   (SeahorsePgpSubkey *se
                                                            const char        *description);
 
 char *              seahorse_pgp_subkey_calc_fingerprint  (const char *raw_fingerprint);
+
+char *              seahorse_pgp_subkey_normalize_fingerprint (const char *fingerprint);
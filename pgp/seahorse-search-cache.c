@@ -0,0 +1,367 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "seahorse-search-cache.h"
+
+#include "seahorse-pgp-uid.h"
+
+#include <string.h>
+
+/* Rough memory cost of a key and a UID, apart from their strings */
+#define KEY_OVERHEAD 1024
+#define UID_OVERHEAD 256
+
+struct _SeahorseSearchCache {
+    GObject parent_instance;
+
+    GHashTable *entries;        /* cache key → link in lru */
+    GQueue lru;                 /* of CacheEntry, most recently used first */
+    unsigned int max_entries;
+    gsize max_size;
+    gsize size;
+    GTimeSpan ttl;
+};
+
+G_DEFINE_TYPE (SeahorseSearchCache, seahorse_search_cache, G_TYPE_OBJECT);
+
+typedef struct {
+    char *key;
+    GPtrArray *keys;
+    gint64 stored;
+    gsize size;
+    gboolean refreshing;
+} CacheEntry;
+
+static void
+cache_entry_free (CacheEntry *entry)
+{
+    g_free (entry->key);
+    g_ptr_array_unref (entry->keys);
+    g_free (entry);
+}
+
+static inline gsize
+string_size (const char *str)
+{
+    return str ? strlen (str) + 1 : 0;
+}
+
+static gsize
+estimate_key_size (SeahorsePgpKey *key)
+{
+    GListModel *uids;
+    gsize size = KEY_OVERHEAD;
+
+    size += string_size (seahorse_pgp_key_get_fingerprint (key));
+
+    uids = seahorse_pgp_key_get_uids (key);
+    for (guint i = 0; i < g_list_model_get_n_items (uids); i++) {
+        g_autoptr(SeahorsePgpUid) uid = g_list_model_get_item (uids, i);
+
+        size += UID_OVERHEAD;
+        size += string_size (seahorse_pgp_uid_get_name (uid));
+        size += string_size (seahorse_pgp_uid_get_email (uid));
+        size += string_size (seahorse_pgp_uid_get_comment (uid));
+    }
+
+    return size;
+}
+
+static char *
+make_cache_key (const char *uri,
+                const char *query)
+{
+    g_autofree char *lower_uri = NULL;
+    g_autofree char *normalized = NULL;
+
+    /* Remotes are compared case-insensitively elsewhere too */
+    lower_uri = g_ascii_strdown (uri, -1);
+    normalized = seahorse_search_cache_normalize_query (query);
+    return g_strdup_printf ("%s\n%s", lower_uri, normalized);
+}
+
+static void
+remove_link (SeahorseSearchCache *self,
+             GList               *link)
+{
+    CacheEntry *entry = link->data;
+
+    g_hash_table_remove (self->entries, entry->key);
+    g_queue_delete_link (&self->lru, link);
+    g_assert (self->size >= entry->size);
+    self->size -= entry->size;
+    cache_entry_free (entry);
+}
+
+static void
+seahorse_search_cache_init (SeahorseSearchCache *self)
+{
+    /* The keys are owned by the entries */
+    self->entries = g_hash_table_new (g_str_hash, g_str_equal);
+    g_queue_init (&self->lru);
+}
+
+static void
+seahorse_search_cache_finalize (GObject *obj)
+{
+    SeahorseSearchCache *self = SEAHORSE_SEARCH_CACHE (obj);
+
+    seahorse_search_cache_clear (self);
+    g_hash_table_unref (self->entries);
+
+    G_OBJECT_CLASS (seahorse_search_cache_parent_class)->finalize (obj);
+}
+
+static void
+seahorse_search_cache_class_init (SeahorseSearchCacheClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->finalize = seahorse_search_cache_finalize;
+}
+
+/**
+ * seahorse_search_cache_new:
+ * @max_entries: The maximum amount of cached searches
+ * @max_size: The maximum estimated memory usage in bytes
+ * @ttl: How long search results stay valid
+ *
+ * Returns: (transfer full): A new, empty search cache
+ */
+SeahorseSearchCache *
+seahorse_search_cache_new (unsigned int max_entries,
+                           gsize        max_size,
+                           GTimeSpan    ttl)
+{
+    SeahorseSearchCache *self;
+
+    g_return_val_if_fail (max_entries > 0, NULL);
+    g_return_val_if_fail (ttl > 0, NULL);
+
+    self = g_object_new (SEAHORSE_TYPE_SEARCH_CACHE, NULL);
+    self->max_entries = max_entries;
+    self->max_size = max_size;
+    self->ttl = ttl;
+    return self;
+}
+
+/**
+ * seahorse_search_cache_normalize_query:
+ * @query: A search string as entered by the user
+ *
+ * Key servers ignore case and surrounding whitespace, so we fold those
+ * (and runs of whitespace) away to make similar queries hit the same entry.
+ *
+ * Returns: (transfer full): The normalized query
+ */
+char *
+seahorse_search_cache_normalize_query (const char *query)
+{
+    g_autofree char *folded = NULL;
+    GString *normalized;
+    gboolean in_space = FALSE;
+
+    g_return_val_if_fail (query != NULL, NULL);
+
+    folded = g_utf8_casefold (query, -1);
+    g_strstrip (folded);
+
+    normalized = g_string_sized_new (strlen (folded));
+    for (const char *p = folded; *p; p++) {
+        if (g_ascii_isspace (*p)) {
+            in_space = TRUE;
+            continue;
+        }
+        if (in_space)
+            g_string_append_c (normalized, ' ');
+        in_space = FALSE;
+        g_string_append_c (normalized, *p);
+    }
+
+    return g_string_free (normalized, FALSE);
+}
+
+/**
+ * seahorse_search_cache_lookup:
+ * @self: A #SeahorseSearchCache
+ * @uri: The URI of the key server
+ * @query: The search string
+ * @needs_refresh: (out) (optional): Set if the caller should refresh the
+ *   entry in the background. Only one caller is asked to do so.
+ *
+ * Looks up the results of an earlier search, and marks it as most recently
+ * used. Expired entries are dropped.
+ *
+ * Returns: (transfer container) (element-type SeahorsePgpKey) (nullable):
+ *   The cached keys, or %NULL on a miss
+ */
+GPtrArray *
+seahorse_search_cache_lookup (SeahorseSearchCache *self,
+                              const char          *uri,
+                              const char          *query,
+                              gboolean            *needs_refresh)
+{
+    g_autofree char *cache_key = NULL;
+    CacheEntry *entry;
+    GList *link;
+    GTimeSpan age;
+
+    g_return_val_if_fail (SEAHORSE_IS_SEARCH_CACHE (self), NULL);
+    g_return_val_if_fail (uri != NULL, NULL);
+    g_return_val_if_fail (query != NULL, NULL);
+
+    if (needs_refresh)
+        *needs_refresh = FALSE;
+
+    cache_key = make_cache_key (uri, query);
+    link = g_hash_table_lookup (self->entries, cache_key);
+    if (link == NULL)
+        return NULL;
+
+    entry = link->data;
+    age = g_get_monotonic_time () - entry->stored;
+    if (age >= self->ttl) {
+        g_debug ("Search cache entry for '%s' on %s expired", query, uri);
+        remove_link (self, link);
+        return NULL;
+    }
+
+    g_queue_unlink (&self->lru, link);
+    g_queue_push_head_link (&self->lru, link);
+
+    if (needs_refresh && !entry->refreshing && age >= self->ttl / 2) {
+        entry->refreshing = TRUE;
+        *needs_refresh = TRUE;
+    }
+
+    return g_ptr_array_ref (entry->keys);
+}
+
+/**
+ * seahorse_search_cache_store:
+ * @self: A #SeahorseSearchCache
+ * @uri: The URI of the key server
+ * @query: The search string
+ * @keys: (element-type SeahorsePgpKey): The keys the server returned
+ *
+ * Stores (or replaces) the results of a search, evicting the least recently
+ * used entries when the limits are exceeded.
+ */
+void
+seahorse_search_cache_store (SeahorseSearchCache *self,
+                             const char          *uri,
+                             const char          *query,
+                             GPtrArray           *keys)
+{
+    CacheEntry *entry;
+    GList *link;
+
+    g_return_if_fail (SEAHORSE_IS_SEARCH_CACHE (self));
+    g_return_if_fail (uri != NULL);
+    g_return_if_fail (query != NULL);
+    g_return_if_fail (keys != NULL);
+
+    entry = g_new0 (CacheEntry, 1);
+    entry->key = make_cache_key (uri, query);
+    entry->stored = g_get_monotonic_time ();
+    entry->size = sizeof (CacheEntry) + strlen (entry->key);
+    entry->keys = g_ptr_array_new_full (keys->len, g_object_unref);
+    for (guint i = 0; i < keys->len; i++) {
+        SeahorsePgpKey *key = g_ptr_array_index (keys, i);
+
+        g_assert (SEAHORSE_PGP_IS_KEY (key));
+        g_ptr_array_add (entry->keys, g_object_ref (key));
+        entry->size += estimate_key_size (key);
+    }
+
+    link = g_hash_table_lookup (self->entries, entry->key);
+    if (link != NULL)
+        remove_link (self, link);
+
+    /* Don't flush the whole cache for a single huge result */
+    if (entry->size > self->max_size) {
+        g_debug ("Not caching search '%s' on %s: too large", query, uri);
+        cache_entry_free (entry);
+        return;
+    }
+
+    g_queue_push_head (&self->lru, entry);
+    g_hash_table_insert (self->entries, entry->key, self->lru.head);
+    self->size += entry->size;
+
+    while (self->lru.length > self->max_entries || self->size > self->max_size)
+        remove_link (self, self->lru.tail);
+}
+
+/**
+ * seahorse_search_cache_invalidate:
+ * @self: A #SeahorseSearchCache
+ * @uri: The URI of the key server
+ * @query: The search string
+ *
+ * Drops the entry for a search, if any.
+ */
+void
+seahorse_search_cache_invalidate (SeahorseSearchCache *self,
+                                  const char          *uri,
+                                  const char          *query)
+{
+    g_autofree char *cache_key = NULL;
+    GList *link;
+
+    g_return_if_fail (SEAHORSE_IS_SEARCH_CACHE (self));
+
+    cache_key = make_cache_key (uri, query);
+    link = g_hash_table_lookup (self->entries, cache_key);
+    if (link != NULL)
+        remove_link (self, link);
+}
+
+/**
+ * seahorse_search_cache_clear:
+ * @self: A #SeahorseSearchCache
+ *
+ * Drops all entries.
+ */
+void
+seahorse_search_cache_clear (SeahorseSearchCache *self)
+{
+    g_return_if_fail (SEAHORSE_IS_SEARCH_CACHE (self));
+
+    while (self->lru.head != NULL)
+        remove_link (self, self->lru.head);
+}
+
+unsigned int
+seahorse_search_cache_get_n_entries (SeahorseSearchCache *self)
+{
+    g_return_val_if_fail (SEAHORSE_IS_SEARCH_CACHE (self), 0);
+
+    return self->lru.length;
+}
+
+gsize
+seahorse_search_cache_get_size (SeahorseSearchCache *self)
+{
+    g_return_val_if_fail (SEAHORSE_IS_SEARCH_CACHE (self), 0);
+
+    return self->size;
+}
@@ -0,0 +1,63 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SeahorseSearchCache: An LRU cache of parsed key server search results
+ *
+ * - Entries are keyed by the key server URI and the normalized query.
+ * - Entries expire after a TTL, and ask for a refresh after half of it.
+ * - The amount of entries and their (estimated) size are bounded.
+ */
+
+#pragma once
+
+#include <glib-object.h>
+
+#include "seahorse-pgp-key.h"
+
+#define SEAHORSE_TYPE_SEARCH_CACHE (seahorse_search_cache_get_type ())
+G_DECLARE_FINAL_TYPE (SeahorseSearchCache, seahorse_search_cache,
+                      SEAHORSE, SEARCH_CACHE,
+                      GObject)
+
+SeahorseSearchCache *  seahorse_search_cache_new             (unsigned int max_entries,
+                                                              gsize        max_size,
+                                                              GTimeSpan    ttl);
+
+GPtrArray *            seahorse_search_cache_lookup          (SeahorseSearchCache *self,
+                                                              const char          *uri,
+                                                              const char          *query,
+                                                              gboolean            *needs_refresh);
+
+void                   seahorse_search_cache_store           (SeahorseSearchCache *self,
+                                                              const char          *uri,
+                                                              const char          *query,
+                                                              GPtrArray           *keys);
+
+void                   seahorse_search_cache_invalidate      (SeahorseSearchCache *self,
+                                                              const char          *uri,
+                                                              const char          *query);
+
+void                   seahorse_search_cache_clear           (SeahorseSearchCache *self);
+
+unsigned int           seahorse_search_cache_get_n_entries   (SeahorseSearchCache *self);
+
+gsize                  seahorse_search_cache_get_size        (SeahorseSearchCache *self);
+
+char *                 seahorse_search_cache_normalize_query (const char *query);
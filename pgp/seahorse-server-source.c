@@ -413,3 +413,200 @@ seahorse_server_source_import_finish (SeahorseServerSource *source,
 	g_return_val_if_fail (SEAHORSE_SERVER_SOURCE_GET_CLASS (source)->import_finish, NULL);
 	return SEAHORSE_SERVER_SOURCE_GET_CLASS (source)->import_finish (source, result, error);
 }
+
+/* Extracts the binary packets from an ASCII armored block */
+static guchar *
+dearmor_key_block (const char *armor,
+                   gsize      *n_data)
+{
+    const char *line, *end;
+    g_autoptr(GString) base64 = NULL;
+    gboolean in_headers = TRUE;
+
+    line = strstr (armor, "-----BEGIN PGP ");
+    if (line == NULL)
+        return NULL;
+    end = strstr (line, "-----END PGP ");
+    if (end == NULL)
+        return NULL;
+
+    /* Skip the armor header line itself */
+    line = strchr (line, '\n');
+    if (line == NULL || line > end)
+        return NULL;
+    line++;
+
+    base64 = g_string_new ("");
+    while (line < end) {
+        const char *eol;
+        size_t len;
+
+        eol = memchr (line, '\n', end - line);
+        if (eol == NULL)
+            eol = end;
+        len = eol - line;
+        if (len > 0 && line[len - 1] == '\r')
+            len--;
+
+        /* Armor headers (eg "Comment: ...") end at the first empty line */
+        if (in_headers) {
+            if (len == 0)
+                in_headers = FALSE;
+            else if (!memchr (line, ':', len))
+                in_headers = FALSE;
+        }
+
+        if (!in_headers) {
+            /* The CRC24 checksum is the only line starting with an '=' */
+            if (len > 0 && line[0] == '=')
+                break;
+            g_string_append_len (base64, line, len);
+        }
+
+        line = eol + 1;
+    }
+
+    if (base64->len == 0)
+        return NULL;
+
+    return g_base64_decode (base64->str, n_data);
+}
+
+/**
+ * seahorse_server_source_calc_armor_fingerprint:
+ * @armor: An ASCII armored public key block
+ *
+ * Calculates the fingerprint of the primary key in @armor, so keys that are
+ * sent to a key server can be reported on without asking GnuPG. Only v4 and
+ * v6 keys are supported.
+ *
+ * Returns: (transfer full) (nullable): The fingerprint as uppercase hex
+ */
+char *
+seahorse_server_source_calc_armor_fingerprint (const char *armor)
+{
+    g_autofree guchar *data = NULL;
+    g_autoptr(GChecksum) checksum = NULL;
+    gsize n_data;
+    gsize header_len;
+    gsize body_len;
+    const guchar *body;
+    guchar prefix[5];
+    guint tag;
+
+    g_return_val_if_fail (armor != NULL, NULL);
+
+    data = dearmor_key_block (armor, &n_data);
+    if (data == NULL || n_data < 2 || !(data[0] & 0x80))
+        return NULL;
+
+    /* Parse the header of the first packet (RFC 4880, section 4.2) */
+    if (data[0] & 0x40) {
+        tag = data[0] & 0x3f;
+        if (data[1] < 192) {
+            body_len = data[1];
+            header_len = 2;
+        } else if (data[1] < 224) {
+            if (n_data < 3)
+                return NULL;
+            body_len = ((data[1] - 192) << 8) + data[2] + 192;
+            header_len = 3;
+        } else if (data[1] == 255) {
+            if (n_data < 6)
+                return NULL;
+            body_len = (data[2] << 24) | (data[3] << 16) | (data[4] << 8) | data[5];
+            header_len = 6;
+        } else {
+            /* Partial body lengths aren't allowed for key packets */
+            return NULL;
+        }
+    } else {
+        tag = (data[0] >> 2) & 0x0f;
+        switch (data[0] & 0x03) {
+        case 0:
+            body_len = data[1];
+            header_len = 2;
+            break;
+        case 1:
+            if (n_data < 3)
+                return NULL;
+            body_len = (data[1] << 8) | data[2];
+            header_len = 3;
+            break;
+        case 2:
+            if (n_data < 5)
+                return NULL;
+            body_len = (data[1] << 24) | (data[2] << 16) | (data[3] << 8) | data[4];
+            header_len = 5;
+            break;
+        default:
+            return NULL;
+        }
+    }
+
+    /* Public-Key Packet */
+    if (tag != 6 || body_len == 0 || header_len + body_len > n_data)
+        return NULL;
+    body = data + header_len;
+
+    switch (body[0]) {
+    case 4:
+        checksum = g_checksum_new (G_CHECKSUM_SHA1);
+        prefix[0] = 0x99;
+        prefix[1] = (body_len >> 8) & 0xff;
+        prefix[2] = body_len & 0xff;
+        g_checksum_update (checksum, prefix, 3);
+        break;
+    case 6:
+        checksum = g_checksum_new (G_CHECKSUM_SHA256);
+        prefix[0] = 0x9b;
+        prefix[1] = (body_len >> 24) & 0xff;
+        prefix[2] = (body_len >> 16) & 0xff;
+        prefix[3] = (body_len >> 8) & 0xff;
+        prefix[4] = body_len & 0xff;
+        g_checksum_update (checksum, prefix, 5);
+        break;
+    default:
+        return NULL;
+    }
+
+    g_checksum_update (checksum, body, body_len);
+    return g_ascii_strup (g_checksum_get_string (checksum), -1);
+}
+
+/**
+ * seahorse_server_source_calc_armor_digest:
+ * @armor: One or more ASCII armored key blocks
+ *
+ * Calculates a digest of the key data in @armor. Armor headers and line
+ * endings differ between key servers returning the same key, so only the
+ * packets themselves are hashed.
+ *
+ * Returns: (transfer full) (nullable): The SHA-256 digest as lowercase hex
+ */
+char *
+seahorse_server_source_calc_armor_digest (const char *armor)
+{
+    g_autoptr(GChecksum) checksum = NULL;
+    const char *block;
+    gboolean any = FALSE;
+
+    g_return_val_if_fail (armor != NULL, NULL);
+
+    checksum = g_checksum_new (G_CHECKSUM_SHA256);
+    for (block = strstr (armor, "-----BEGIN PGP "); block != NULL;
+         block = strstr (block + 1, "-----BEGIN PGP ")) {
+        g_autofree guchar *data = NULL;
+        gsize n_data;
+
+        data = dearmor_key_block (block, &n_data);
+        if (data == NULL)
+            continue;
+        g_checksum_update (checksum, data, n_data);
+        any = TRUE;
+    }
+
+    if (!any)
+        return NULL;
+    return g_strdup (g_checksum_get_string (checksum));
+}
@@ -114,3 +114,7 @@ gpointer               seahorse_server_source_export_finish    (SeahorseServerSo
                                                                 GAsyncResult *result,
                                                                 gsize *size,
                                                                 GError **error);
+
+char *                 seahorse_server_source_calc_armor_fingerprint (const char *armor);
+
+char *                 seahorse_server_source_calc_armor_digest      (const char *armor);
@@ -0,0 +1,151 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "seahorse-discovery-cache.h"
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#define SERVER "hkps://keys.example.org"
+#define IPV6_SERVER "hkp://[2001:db8::1]:11371"
+
+static void
+test_discovery_cache_record (void)
+{
+    g_autoptr(SeahorseDiscoveryCache) cache = NULL;
+
+    cache = seahorse_discovery_cache_new (NULL, G_TIME_SPAN_DAY, G_TIME_SPAN_HOUR);
+
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, SERVER, "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_UNKNOWN);
+
+    seahorse_discovery_cache_record (cache, SERVER, "0123456789ABCDEF", TRUE);
+    seahorse_discovery_cache_record (cache, SERVER, "FEDCBA9876543210", FALSE);
+
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, SERVER, "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_FOUND);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, SERVER, "FEDCBA9876543210"),
+                     ==, SEAHORSE_DISCOVERY_MISSING);
+
+    /* Fingerprints share the entry of their key id, in any case */
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, "HKPS://keys.example.org",
+                                                      "00112233445566778899aabbfedcba9876543210"),
+                     ==, SEAHORSE_DISCOVERY_MISSING);
+
+    /* Other servers are asked separately */
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, "ldap://ldap.example.org",
+                                                      "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_UNKNOWN);
+}
+
+static void
+test_discovery_cache_expiry (void)
+{
+    g_autoptr(SeahorseDiscoveryCache) cache = NULL;
+
+    /* Missing keys aren't remembered at all here */
+    cache = seahorse_discovery_cache_new (NULL, G_TIME_SPAN_DAY, 0);
+
+    seahorse_discovery_cache_record (cache, SERVER, "0123456789ABCDEF", TRUE);
+    seahorse_discovery_cache_record (cache, SERVER, "FEDCBA9876543210", FALSE);
+
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, SERVER, "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_FOUND);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, SERVER, "FEDCBA9876543210"),
+                     ==, SEAHORSE_DISCOVERY_UNKNOWN);
+}
+
+static void
+test_discovery_cache_ipv6 (void)
+{
+    g_autoptr(SeahorseDiscoveryCache) cache = NULL;
+    g_autoptr(SeahorseDiscoveryCache) reloaded = NULL;
+    g_autoptr(GError) error = NULL;
+    g_autofree char *tmpdir = NULL;
+    g_autofree char *filename = NULL;
+
+    tmpdir = g_dir_make_tmp ("seahorse-discovery-XXXXXX", &error);
+    g_assert_no_error (error);
+    filename = g_build_filename (tmpdir, "discovery-cache.ini", NULL);
+
+    /* The brackets can't be used as they are in a key file */
+    cache = seahorse_discovery_cache_new (filename, G_TIME_SPAN_DAY, G_TIME_SPAN_HOUR);
+    seahorse_discovery_cache_record (cache, IPV6_SERVER, "0123456789ABCDEF", TRUE);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, IPV6_SERVER, "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_FOUND);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (cache, "hkp://[2001:db8::2]:11371",
+                                                      "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_UNKNOWN);
+    seahorse_discovery_cache_save (cache, &error);
+    g_assert_no_error (error);
+
+    reloaded = seahorse_discovery_cache_new (filename, G_TIME_SPAN_DAY, G_TIME_SPAN_HOUR);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (reloaded, "HKP://[2001:DB8::1]:11371",
+                                                      "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_FOUND);
+
+    g_assert_cmpint (g_unlink (filename), ==, 0);
+    g_assert_cmpint (g_rmdir (tmpdir), ==, 0);
+}
+
+static void
+test_discovery_cache_persist (void)
+{
+    g_autoptr(SeahorseDiscoveryCache) cache = NULL;
+    g_autoptr(SeahorseDiscoveryCache) reloaded = NULL;
+    g_autoptr(GError) error = NULL;
+    g_autofree char *tmpdir = NULL;
+    g_autofree char *filename = NULL;
+    g_autofree char *dirname = NULL;
+
+    tmpdir = g_dir_make_tmp ("seahorse-discovery-XXXXXX", &error);
+    g_assert_no_error (error);
+    dirname = g_build_filename (tmpdir, "seahorse", NULL);
+    filename = g_build_filename (dirname, "discovery-cache.ini", NULL);
+
+    cache = seahorse_discovery_cache_new (filename, G_TIME_SPAN_DAY, G_TIME_SPAN_HOUR);
+    seahorse_discovery_cache_record (cache, SERVER, "0123456789ABCDEF", TRUE);
+    seahorse_discovery_cache_record (cache, SERVER, "FEDCBA9876543210", FALSE);
+    seahorse_discovery_cache_save (cache, &error);
+    g_assert_no_error (error);
+
+    /* A new session doesn't need to ask again */
+    reloaded = seahorse_discovery_cache_new (filename, G_TIME_SPAN_DAY, G_TIME_SPAN_HOUR);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (reloaded, SERVER, "0123456789ABCDEF"),
+                     ==, SEAHORSE_DISCOVERY_FOUND);
+    g_assert_cmpint (seahorse_discovery_cache_lookup (reloaded, SERVER, "FEDCBA9876543210"),
+                     ==, SEAHORSE_DISCOVERY_MISSING);
+
+    g_assert_cmpint (g_unlink (filename), ==, 0);
+    g_assert_cmpint (g_rmdir (dirname), ==, 0);
+    g_assert_cmpint (g_rmdir (tmpdir), ==, 0);
+}
+
+int
+main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/discovery-cache/record", test_discovery_cache_record);
+    g_test_add_func ("/discovery-cache/expiry", test_discovery_cache_expiry);
+    g_test_add_func ("/discovery-cache/ipv6", test_discovery_cache_ipv6);
+    g_test_add_func ("/discovery-cache/persist", test_discovery_cache_persist);
+
+    return g_test_run ();
+}
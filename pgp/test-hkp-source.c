@@ -18,10 +18,15 @@
  */
 
 #include "seahorse-hkp-source.h"
+#include "seahorse-server-source.h"
 #include "seahorse-pgp-key.h"
 #include "seahorse-pgp-uid.h"
+#include "test-server-source-util.h"
 
 #include <glib.h>
+#include <libsoup/soup.h>
+
+#include <string.h>
 
 static void
 test_hkp_lookup_response_simple_no_uid (void)
@@ -131,6 +136,505 @@ test_hkp_is_valid_uri (void)
     g_assert_false (seahorse_hkp_is_valid_uri ("ldap://keys.openpgp.org"));
 }
 
+static void
+test_hkp_armor_fingerprint (void)
+{
+    g_autofree char *fpr = NULL;
+
+    fpr = seahorse_server_source_calc_armor_fingerprint (
+        "-----BEGIN PGP PUBLIC KEY BLOCK-----\n"
+        "Comment: Test Key <test@example.org>\n"
+        "\n"
+        "mDMEatZQ3hYJKwYBBAHaRw8BAQdAiKFAunMk4ULBWu3x76Lxnc7R3mMAIOX7lwui\n"
+        "GHZoRAu0G1Rlc3QgS2V5IDx0ZXN0QGV4YW1wbGUub3JnPoiQBBMWCAA4FiEE/406\n"
+        "ve+7TMKM8EKq3T9jiiF/nzAFAmrWUN4CGwMFCwkIBwIGFQoJCAsCBBYCAwECHgEC\n"
+        "F4AACgkQ3T9jiiF/nzBGzwEAn35HAkfheibaNrgsTo+U7V9n6aMoOW4T9cwvYjga\n"
+        "O4AA/j7tFup2wTKHd7sk3CRewpFMvWNWztypkw+2U4W3cv8L\n"
+        "=wtgu\n"
+        "-----END PGP PUBLIC KEY BLOCK-----\n"
+    );
+    g_assert_cmpstr (fpr, ==, "FF8D3ABDEFBB4CC28CF042AADD3F638A217F9F30");
+
+    /* Not a key block */
+    g_clear_pointer (&fpr, g_free);
+    fpr = seahorse_server_source_calc_armor_fingerprint ("Hello world\n");
+    g_assert_null (fpr);
+}
+
+/*
+ * A local HKP key server, so the source can be driven end to end (and
+ * timed) without the network. The latency of every response and the amount
+ * of keys are configurable.
+ */
+
+typedef struct {
+    SoupServer *server;
+    GUri *uri;
+    unsigned int latency;       /* In milliseconds */
+    GPtrArray *keys;            /* Armored key blocks, the index is the key id */
+    GHashTable *added;          /* Key data that was added → TRUE */
+    gboolean etags;             /* Whether keys are sent with an ETag */
+    unsigned int n_requests;
+    unsigned int n_not_modified;
+    guint64 n_bytes_in;
+    guint64 n_bytes_out;
+} MockServer;
+
+static void
+mock_server_seed (MockServer  *server,
+                  unsigned int n_keys)
+{
+    for (unsigned int i = 0; i < n_keys; i++)
+        g_ptr_array_add (server->keys, test_make_key_data (server->keys->len));
+}
+
+static char *
+mock_server_index (MockServer *server,
+                   const char *search)
+{
+    g_autoptr(GString) body = g_string_new (NULL);
+    g_autofree char *needle = g_ascii_strdown (search, -1);
+    unsigned int n_found = 0;
+
+    for (unsigned int i = 0; i < server->keys->len; i++) {
+        g_autofree char *uid = g_strdup_printf ("User %u <user%u@example.org>", i, i);
+        g_autofree char *uid_down = g_ascii_strdown (uid, -1);
+        g_autofree char *fpr = g_strdup_printf ("%040X", i);
+        g_autofree char *escaped = NULL;
+
+        if (strstr (uid_down, needle) == NULL)
+            continue;
+
+        escaped = g_uri_escape_string (uid, " ", FALSE);
+        g_string_append_printf (body, "pub:%s:1:3072:1577934245::\n", fpr);
+        g_string_append_printf (body, "uid:%s:1577934245::\n", escaped);
+        n_found++;
+    }
+
+    return g_strdup_printf ("info:1:%u\n%s", n_found, body->str);
+}
+
+typedef struct {
+    SoupServer *server;
+    SoupServerMessage *msg;
+} DelayedResponse;
+
+static void
+delayed_response_free (gpointer data)
+{
+    DelayedResponse *delayed = data;
+    g_object_unref (delayed->server);
+    g_object_unref (delayed->msg);
+    g_free (delayed);
+}
+
+static gboolean
+on_mock_response_delayed (gpointer user_data)
+{
+    DelayedResponse *delayed = user_data;
+
+#if SOUP_CHECK_VERSION (3, 2, 0)
+    soup_server_message_unpause (delayed->msg);
+#else
+    soup_server_unpause_message (delayed->server, delayed->msg);
+#endif
+    return G_SOURCE_REMOVE;
+}
+
+static void
+mock_server_respond (MockServer        *server,
+                     SoupServerMessage *msg,
+                     unsigned int       status,
+                     const char        *body)
+{
+    DelayedResponse *delayed;
+    size_t len = strlen (body);
+
+    server->n_bytes_out += len;
+    soup_server_message_set_status (msg, status, NULL);
+    soup_server_message_set_response (msg, "text/plain", SOUP_MEMORY_COPY, body, len);
+
+    if (server->latency == 0)
+        return;
+
+    delayed = g_new0 (DelayedResponse, 1);
+    delayed->server = g_object_ref (server->server);
+    delayed->msg = g_object_ref (msg);
+#if SOUP_CHECK_VERSION (3, 2, 0)
+    soup_server_message_pause (msg);
+#else
+    soup_server_pause_message (server->server, msg);
+#endif
+    g_timeout_add_full (G_PRIORITY_DEFAULT, server->latency,
+                        on_mock_response_delayed,
+                        delayed, delayed_response_free);
+}
+
+static void
+on_mock_lookup (SoupServer        *soup_server,
+                SoupServerMessage *msg,
+                const char        *path,
+                GHashTable        *query,
+                gpointer           user_data)
+{
+    MockServer *server = user_data;
+    const char *op = query ? g_hash_table_lookup (query, "op") : NULL;
+    const char *search = query ? g_hash_table_lookup (query, "search") : NULL;
+    g_autofree char *body = NULL;
+    unsigned int n;
+
+    server->n_requests++;
+
+    if (search == NULL) {
+        mock_server_respond (server, msg, SOUP_STATUS_BAD_REQUEST, "Error: no search");
+        return;
+    }
+
+    if (g_strcmp0 (op, "index") == 0) {
+        body = mock_server_index (server, search);
+        mock_server_respond (server, msg, SOUP_STATUS_OK, body);
+        return;
+    }
+
+    /* op=get, with a key id. The seeded keys have their index as key id */
+    if (g_str_has_prefix (search, "0x"))
+        search += 2;
+    n = g_ascii_strtoull (search, NULL, 16);
+    if (g_strcmp0 (op, "get") != 0 || n >= server->keys->len) {
+        mock_server_respond (server, msg, SOUP_STATUS_NOT_FOUND, "No results found");
+        return;
+    }
+
+    if (server->etags) {
+        SoupMessageHeaders *headers;
+        g_autofree char *digest = NULL;
+        g_autofree char *etag = NULL;
+        const char *match;
+
+        digest = g_compute_checksum_for_string (G_CHECKSUM_MD5,
+                                                g_ptr_array_index (server->keys, n), -1);
+        etag = g_strdup_printf ("\"%s\"", digest);
+
+        headers = soup_server_message_get_request_headers (msg);
+        match = soup_message_headers_get_one (headers, "If-None-Match");
+        if (g_strcmp0 (match, etag) == 0) {
+            server->n_not_modified++;
+            mock_server_respond (server, msg, SOUP_STATUS_NOT_MODIFIED, "");
+            return;
+        }
+
+        headers = soup_server_message_get_response_headers (msg);
+        soup_message_headers_replace (headers, "ETag", etag);
+    }
+
+    body = g_strdup_printf ("<html><body><pre>\n%s\n</pre></body></html>",
+                            (char *) g_ptr_array_index (server->keys, n));
+    mock_server_respond (server, msg, SOUP_STATUS_OK, body);
+}
+
+static void
+on_mock_add (SoupServer        *soup_server,
+             SoupServerMessage *msg,
+             const char        *path,
+             GHashTable        *query,
+             gpointer           user_data)
+{
+    MockServer *server = user_data;
+    g_autoptr(GBytes) request = NULL;
+    g_autoptr(GHashTable) form = NULL;
+    g_autofree char *encoded = NULL;
+    const char *keytext;
+    gsize len;
+
+    server->n_requests++;
+
+    request = soup_message_body_flatten (soup_server_message_get_request_body (msg));
+    encoded = g_strndup (g_bytes_get_data (request, &len), g_bytes_get_size (request));
+    server->n_bytes_in += len;
+
+    form = soup_form_decode (encoded);
+    keytext = g_hash_table_lookup (form, "keytext");
+    if (keytext == NULL) {
+        mock_server_respond (server, msg, SOUP_STATUS_BAD_REQUEST, "Error: no keytext");
+        return;
+    }
+
+    if (strstr (keytext, "rejected") != NULL) {
+        mock_server_respond (server, msg, SOUP_STATUS_UNPROCESSABLE_ENTITY,
+                             "Error: key rejected");
+        return;
+    }
+
+    g_hash_table_add (server->added, g_strdup (keytext));
+    mock_server_respond (server, msg, SOUP_STATUS_OK, "Key block added");
+}
+
+static MockServer *
+mock_server_start (unsigned int latency)
+{
+    MockServer *server;
+    g_autoptr(GError) error = NULL;
+    GSList *uris;
+
+    server = g_new0 (MockServer, 1);
+    server->latency = latency;
+    server->etags = TRUE;
+    server->keys = g_ptr_array_new_with_free_func (g_free);
+    server->added = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    server->server = soup_server_new (NULL, NULL);
+    soup_server_add_handler (server->server, "/pks/lookup", on_mock_lookup, server, NULL);
+    soup_server_add_handler (server->server, "/pks/add", on_mock_add, server, NULL);
+    soup_server_listen_local (server->server, 0, SOUP_SERVER_LISTEN_IPV4_ONLY, &error);
+    g_assert_no_error (error);
+
+    uris = soup_server_get_uris (server->server);
+    g_assert_nonnull (uris);
+    server->uri = g_uri_ref (uris->data);
+    g_slist_free_full (uris, (GDestroyNotify) g_uri_unref);
+
+    return server;
+}
+
+static void
+mock_server_stop (MockServer *server)
+{
+    soup_server_disconnect (server->server);
+    g_object_unref (server->server);
+    g_uri_unref (server->uri);
+    g_ptr_array_unref (server->keys);
+    g_hash_table_unref (server->added);
+    g_free (server);
+}
+
+typedef struct {
+    MockServer *server;
+    SeahorseHKPSource *source;
+} MockFixture;
+
+static void
+mock_fixture_start (MockFixture  *fixture,
+                    unsigned int  latency)
+{
+    g_autofree char *uri = NULL;
+
+    fixture->server = mock_server_start (latency);
+    uri = g_strdup_printf ("hkp://127.0.0.1:%d", g_uri_get_port (fixture->server->uri));
+    fixture->source = seahorse_hkp_source_new (uri);
+    g_assert_nonnull (fixture->source);
+}
+
+static void
+mock_fixture_setup (MockFixture  *fixture,
+                    gconstpointer user_data)
+{
+    mock_fixture_start (fixture, 0);
+}
+
+static void
+mock_fixture_teardown (MockFixture  *fixture,
+                       gconstpointer user_data)
+{
+    g_clear_object (&fixture->source);
+    mock_server_stop (fixture->server);
+}
+
+static void
+test_hkp_search (MockFixture  *fixture,
+                 gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_autoptr(GcrSimpleCollection) results = NULL;
+    g_autoptr(GError) error = NULL;
+
+    mock_server_seed (fixture->server, 100);
+
+    /* user7, user70 - user79 */
+    results = test_server_source_search (source, "user7", &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (results)), ==, 11);
+    g_assert_cmpuint (fixture->server->n_requests, ==, 1);
+}
+
+static void
+test_hkp_export (MockFixture  *fixture,
+                 gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_auto(GStrv) keyids = NULL;
+    g_autofree char *data = NULL;
+    g_autoptr(GError) error = NULL;
+
+    mock_server_seed (fixture->server, 50);
+
+    /* A request per key, the ones the server doesn't have are missing */
+    keyids = test_make_keyids (40, 20, 40);
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (data);
+    g_assert_cmpuint (test_count_blocks (data), ==, 10);
+    g_assert_nonnull (strstr (data, "c3ludGhldGlj00000028\n-----END PGP PUBLIC KEY BLOCK-----"));
+    g_assert_cmpuint (fixture->server->n_requests, ==, 20);
+}
+
+static void
+test_hkp_export_unchanged (MockFixture  *fixture,
+                           gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_autoptr(GcrSimpleCollection) known = NULL;
+    g_autoptr(GList) objects = NULL;
+    g_auto(GStrv) keyids = NULL;
+    g_autofree char *data = NULL;
+    g_autoptr(GError) error = NULL;
+
+    mock_server_seed (fixture->server, 10);
+    keyids = test_make_keyids (0, 10, 40);
+
+    /* Keys we don't have are always sent */
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 10);
+    g_clear_pointer (&data, g_free);
+
+    known = test_server_source_search (source, "example.org", &error);
+    g_assert_no_error (error);
+    seahorse_hkp_source_set_known_keys (fixture->source, GCR_COLLECTION (known));
+
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 0);
+    g_assert_cmpuint (fixture->server->n_not_modified, ==, 10);
+    g_clear_pointer (&data, g_free);
+
+    /* Only the key that changed on the server is sent again */
+    g_free (g_ptr_array_index (fixture->server->keys, 3));
+    g_ptr_array_index (fixture->server->keys, 3) =
+        g_strdup ("-----BEGIN PGP PUBLIC KEY BLOCK-----\n\n"
+                  "dXBkYXRlZA\n"
+                  "-----END PGP PUBLIC KEY BLOCK-----");
+
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 1);
+    g_assert_nonnull (strstr (data, "dXBkYXRlZA"));
+    g_assert_cmpuint (fixture->server->n_not_modified, ==, 19);
+    g_clear_pointer (&data, g_free);
+
+    /* Without an ETag, the same key still isn't imported again */
+    fixture->server->etags = FALSE;
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 0);
+    g_assert_cmpuint (fixture->server->n_not_modified, ==, 19);
+    g_clear_pointer (&data, g_free);
+
+    /* A key that isn't known anymore is sent again */
+    objects = gcr_collection_get_objects (GCR_COLLECTION (known));
+    gcr_simple_collection_remove (known, objects->data);
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 1);
+
+    g_assert_cmpuint (fixture->server->n_requests, ==, 51);
+}
+
+static void
+test_hkp_import (MockFixture  *fixture,
+                 gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_autoptr(GError) error = NULL;
+    g_autofree char *rejected = NULL;
+    g_autofree char *accepted = NULL;
+    g_autofree char *both = NULL;
+
+    rejected = test_make_armor (0, 3, "rejected");
+    accepted = test_make_armor (0, 20, "YWNjZXB0ZWQ");
+    both = g_strconcat (accepted, rejected, NULL);
+
+    /* The refused keys are reported, without stopping the others */
+    g_assert_false (test_server_source_import (source, both, &error));
+    g_assert_error (error, HKP_ERROR_DOMAIN, 0);
+    g_assert_nonnull (strstr (error->message, "3 keys out of 23"));
+    g_assert_cmpuint (g_hash_table_size (fixture->server->added), ==, 20);
+    g_assert_cmpuint (fixture->server->n_requests, ==, 23);
+}
+
+/* Run with -m perf. The amount of keys and the latency of the server (in
+ * milliseconds) can be changed with SEAHORSE_HKP_BENCHMARK_KEYS and
+ * SEAHORSE_HKP_BENCHMARK_LATENCY */
+static unsigned int
+get_benchmark_setting (const char  *name,
+                       unsigned int fallback)
+{
+    const char *value = g_getenv (name);
+
+    return value ? (unsigned int) g_ascii_strtoull (value, NULL, 10) : fallback;
+}
+
+static void
+benchmark_fixture_setup (MockFixture  *fixture,
+                         gconstpointer user_data)
+{
+    mock_fixture_start (fixture,
+                        get_benchmark_setting ("SEAHORSE_HKP_BENCHMARK_LATENCY", 20));
+    mock_server_seed (fixture->server,
+                      get_benchmark_setting ("SEAHORSE_HKP_BENCHMARK_KEYS", 2000));
+}
+
+static void
+report_benchmark (MockFixture *fixture,
+                  const char  *what,
+                  double       elapsed)
+{
+    MockServer *server = fixture->server;
+
+    g_test_minimized_result (elapsed,
+                             "%s: %u requests in %.3f seconds (%.1f requests/s), "
+                             "%" G_GUINT64_FORMAT " bytes sent, "
+                             "%" G_GUINT64_FORMAT " bytes received, latency %u ms",
+                             what, server->n_requests, elapsed,
+                             server->n_requests / MAX (elapsed, 0.000001),
+                             server->n_bytes_in, server->n_bytes_out,
+                             server->latency);
+}
+
+static void
+test_hkp_benchmark_search (MockFixture  *fixture,
+                           gconstpointer user_data)
+{
+    double elapsed;
+
+    elapsed = test_server_source_time_search (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              "example.org", fixture->server->keys->len);
+    report_benchmark (fixture, "Search", elapsed);
+}
+
+static void
+test_hkp_benchmark_export (MockFixture  *fixture,
+                           gconstpointer user_data)
+{
+    double elapsed;
+
+    elapsed = test_server_source_time_export (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              fixture->server->keys->len, 40);
+    report_benchmark (fixture, "Export", elapsed);
+}
+
+static void
+test_hkp_benchmark_import (MockFixture  *fixture,
+                           gconstpointer user_data)
+{
+    double elapsed;
+
+    elapsed = test_server_source_time_import (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              fixture->server->keys->len);
+    g_assert_cmpuint (g_hash_table_size (fixture->server->added), ==,
+                      fixture->server->keys->len);
+    report_benchmark (fixture, "Import", elapsed);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -140,6 +644,24 @@ main (int argc, char **argv)
     g_test_add_func ("/hkp/lookup-response-empty", test_hkp_lookup_response_empty);
     g_test_add_func ("/hkp/lookup-response-simple", test_hkp_lookup_response_simple);
     g_test_add_func ("/hkp/lookup-response-simple-no-uid", test_hkp_lookup_response_simple_no_uid);
+    g_test_add_func ("/hkp/armor-fingerprint", test_hkp_armor_fingerprint);
+    g_test_add ("/hkp/search", MockFixture, NULL,
+                mock_fixture_setup, test_hkp_search, mock_fixture_teardown);
+    g_test_add ("/hkp/export", MockFixture, NULL,
+                mock_fixture_setup, test_hkp_export, mock_fixture_teardown);
+    g_test_add ("/hkp/export-unchanged", MockFixture, NULL,
+                mock_fixture_setup, test_hkp_export_unchanged, mock_fixture_teardown);
+    g_test_add ("/hkp/import", MockFixture, NULL,
+                mock_fixture_setup, test_hkp_import, mock_fixture_teardown);
+
+    if (g_test_perf ()) {
+        g_test_add ("/hkp/benchmark/search", MockFixture, NULL,
+                    benchmark_fixture_setup, test_hkp_benchmark_search, mock_fixture_teardown);
+        g_test_add ("/hkp/benchmark/export", MockFixture, NULL,
+                    benchmark_fixture_setup, test_hkp_benchmark_export, mock_fixture_teardown);
+        g_test_add ("/hkp/benchmark/import", MockFixture, NULL,
+                    benchmark_fixture_setup, test_hkp_benchmark_import, mock_fixture_teardown);
+    }
 
     return g_test_run ();
 }
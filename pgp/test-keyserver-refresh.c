@@ -0,0 +1,278 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "seahorse-keyserver-refresh.h"
+#include "seahorse-pgp-backend.h"
+#include "seahorse-server-source.h"
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <string.h>
+
+static SeahorseKeyserverRefresh *
+make_refresh (const char *filename)
+{
+    g_autoptr(GListStore) remotes = NULL;
+
+    remotes = g_list_store_new (SEAHORSE_TYPE_SERVER_SOURCE);
+    return seahorse_keyserver_refresh_new (seahorse_pgp_backend_get_default_keyring (NULL),
+                                           G_LIST_MODEL (remotes), filename);
+}
+
+/* A made up v4 public key packet, followed by a user id packet. Only the
+ * bytes of the first packet make up the fingerprint. */
+static char *
+make_armor (guint8      id,
+            const char *uid,
+            const char *headers)
+{
+    const guint8 key[] = { 0x98, 10, 4, 0x65, 0x00, 0x00, id, 22, 0x01, 0x02, 0x03, id };
+    g_autoptr(GByteArray) packets = NULL;
+    g_autofree char *base64 = NULL;
+    guint8 uid_header[2];
+
+    packets = g_byte_array_new ();
+    g_byte_array_append (packets, key, sizeof (key));
+    uid_header[0] = 0xb4;
+    uid_header[1] = strlen (uid);
+    g_byte_array_append (packets, uid_header, sizeof (uid_header));
+    g_byte_array_append (packets, (const guint8 *) uid, strlen (uid));
+
+    base64 = g_base64_encode (packets->data, packets->len);
+    return g_strdup_printf ("-----BEGIN PGP PUBLIC KEY BLOCK-----\n"
+                            "%s\n"
+                            "%s\n"
+                            "-----END PGP PUBLIC KEY BLOCK-----\n",
+                            headers ? headers : "", base64);
+}
+
+static GBytes *
+filter_changed (SeahorseKeyserverRefresh *refresh,
+                const char               *data,
+                GHashTable              **digests)
+{
+    return seahorse_keyserver_refresh_filter_changed (refresh, data, strlen (data), digests);
+}
+
+static void
+test_keyserver_refresh_filter (void)
+{
+    g_autoptr(SeahorseKeyserverRefresh) refresh = NULL;
+    g_autoptr(GHashTable) digests = NULL;
+    g_autoptr(GBytes) changed = NULL;
+    g_autofree char *alice = NULL;
+    g_autofree char *bob = NULL;
+    g_autofree char *both = NULL;
+    g_autofree char *alice_fpr = NULL;
+    g_autofree char *bob_fpr = NULL;
+    const char *fingerprints[3];
+
+    refresh = make_refresh (NULL);
+    alice = make_armor (1, "Alice", NULL);
+    bob = make_armor (2, "Bob", NULL);
+    both = g_strconcat (alice, bob, NULL);
+    alice_fpr = seahorse_server_source_calc_armor_fingerprint (alice);
+    bob_fpr = seahorse_server_source_calc_armor_fingerprint (bob);
+    g_assert_nonnull (alice_fpr);
+    g_assert_nonnull (bob_fpr);
+
+    /* Nothing is known yet */
+    changed = filter_changed (refresh, both, &digests);
+    g_assert_nonnull (changed);
+    g_assert_cmpuint (g_bytes_get_size (changed), ==, strlen (both));
+    g_assert_cmpuint (g_hash_table_size (digests), ==, 2);
+
+    fingerprints[0] = alice_fpr;
+    fingerprints[1] = bob_fpr;
+    fingerprints[2] = NULL;
+    seahorse_keyserver_refresh_record (refresh, fingerprints, digests);
+    g_clear_pointer (&digests, g_hash_table_unref);
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* So then nothing changed */
+    changed = filter_changed (refresh, both, &digests);
+    g_assert_null (changed);
+    g_assert_cmpuint (g_hash_table_size (digests), ==, 0);
+    g_clear_pointer (&digests, g_hash_table_unref);
+}
+
+static void
+test_keyserver_refresh_formatting (void)
+{
+    g_autoptr(SeahorseKeyserverRefresh) refresh = NULL;
+    g_autoptr(GHashTable) digests = NULL;
+    g_autoptr(GBytes) changed = NULL;
+    g_autofree char *alice = NULL;
+    g_autofree char *alice_fpr = NULL;
+    g_autofree char *headers = NULL;
+    g_autofree char *crlf = NULL;
+    g_auto(GStrv) lines = NULL;
+    const char *fingerprints[2] = { NULL, NULL };
+
+    refresh = make_refresh (NULL);
+    alice = make_armor (1, "Alice", NULL);
+    alice_fpr = seahorse_server_source_calc_armor_fingerprint (alice);
+
+    changed = filter_changed (refresh, alice, &digests);
+    fingerprints[0] = alice_fpr;
+    seahorse_keyserver_refresh_record (refresh, fingerprints, digests);
+    g_clear_pointer (&digests, g_hash_table_unref);
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* Another server might add its own armor headers */
+    headers = make_armor (1, "Alice", "Version: Other Server 1.0\nComment: Hi\n");
+    changed = filter_changed (refresh, headers, NULL);
+    g_assert_null (changed);
+
+    /* Or use other line endings */
+    lines = g_strsplit (alice, "\n", -1);
+    crlf = g_strjoinv ("\r\n", lines);
+    changed = filter_changed (refresh, crlf, NULL);
+    g_assert_null (changed);
+}
+
+static void
+test_keyserver_refresh_updated (void)
+{
+    g_autoptr(SeahorseKeyserverRefresh) refresh = NULL;
+    g_autoptr(GHashTable) digests = NULL;
+    g_autoptr(GBytes) changed = NULL;
+    g_autofree char *alice = NULL;
+    g_autofree char *bob = NULL;
+    g_autofree char *both = NULL;
+    g_autofree char *updated = NULL;
+    g_autofree char *alice_fpr = NULL;
+    g_autofree char *bob_fpr = NULL;
+    const char *fingerprints[3];
+    const char *bogus =
+        "-----BEGIN PGP PUBLIC KEY BLOCK-----\n"
+        "\n"
+        "bm90IGEga2V5\n"
+        "-----END PGP PUBLIC KEY BLOCK-----\n";
+
+    refresh = make_refresh (NULL);
+    alice = make_armor (1, "Alice", NULL);
+    bob = make_armor (2, "Bob", NULL);
+    both = g_strconcat (alice, bob, NULL);
+    alice_fpr = seahorse_server_source_calc_armor_fingerprint (alice);
+    bob_fpr = seahorse_server_source_calc_armor_fingerprint (bob);
+
+    changed = filter_changed (refresh, both, &digests);
+    fingerprints[0] = alice_fpr;
+    fingerprints[1] = bob_fpr;
+    fingerprints[2] = NULL;
+    seahorse_keyserver_refresh_record (refresh, fingerprints, digests);
+    g_clear_pointer (&digests, g_hash_table_unref);
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* Alice got a new user id: only her key is imported */
+    g_free (alice);
+    alice = make_armor (1, "Alice <alice@example.org>", NULL);
+    g_free (both);
+    both = g_strconcat (alice, bob, NULL);
+
+    changed = filter_changed (refresh, both, &digests);
+    g_assert_nonnull (changed);
+    g_assert_cmpuint (g_bytes_get_size (changed), ==, strlen (alice));
+    g_assert_cmpuint (g_hash_table_size (digests), ==, 1);
+    g_assert_true (g_hash_table_contains (digests, alice_fpr));
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* An import that failed doesn't record the digests */
+    seahorse_keyserver_refresh_record (refresh, fingerprints, NULL);
+    g_clear_pointer (&digests, g_hash_table_unref);
+    changed = filter_changed (refresh, both, &digests);
+    g_assert_nonnull (changed);
+    g_assert_cmpuint (g_hash_table_size (digests), ==, 1);
+    g_clear_pointer (&digests, g_hash_table_unref);
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* Blocks we can't tell the fingerprint of are always imported */
+    updated = g_strconcat (bogus, bob, NULL);
+    changed = filter_changed (refresh, updated, &digests);
+    g_assert_nonnull (changed);
+    g_assert_cmpuint (g_bytes_get_size (changed), ==, strlen (bogus));
+    g_assert_cmpuint (g_hash_table_size (digests), ==, 0);
+}
+
+static void
+test_keyserver_refresh_persist (void)
+{
+    g_autoptr(SeahorseKeyserverRefresh) refresh = NULL;
+    g_autoptr(SeahorseKeyserverRefresh) reloaded = NULL;
+    g_autoptr(GHashTable) digests = NULL;
+    g_autoptr(GBytes) changed = NULL;
+    g_autoptr(GError) error = NULL;
+    g_autofree char *tmpdir = NULL;
+    g_autofree char *dirname = NULL;
+    g_autofree char *filename = NULL;
+    g_autofree char *alice = NULL;
+    g_autofree char *alice_fpr = NULL;
+    const char *fingerprints[2] = { NULL, NULL };
+
+    tmpdir = g_dir_make_tmp ("seahorse-refresh-XXXXXX", &error);
+    g_assert_no_error (error);
+    dirname = g_build_filename (tmpdir, "seahorse", NULL);
+    filename = g_build_filename (dirname, "refresh-state.ini", NULL);
+
+    alice = make_armor (1, "Alice", NULL);
+    alice_fpr = seahorse_server_source_calc_armor_fingerprint (alice);
+    fingerprints[0] = alice_fpr;
+
+    refresh = make_refresh (filename);
+    changed = filter_changed (refresh, alice, &digests);
+    seahorse_keyserver_refresh_record (refresh, fingerprints, digests);
+    seahorse_keyserver_refresh_save (refresh, &error);
+    g_assert_no_error (error);
+    g_clear_pointer (&changed, g_bytes_unref);
+
+    /* A new session doesn't import it again */
+    reloaded = make_refresh (filename);
+    changed = filter_changed (reloaded, alice, NULL);
+    g_assert_null (changed);
+
+    g_assert_cmpint (g_unlink (filename), ==, 0);
+    g_assert_cmpint (g_rmdir (dirname), ==, 0);
+    g_assert_cmpint (g_rmdir (tmpdir), ==, 0);
+}
+
+int
+main (int argc, char **argv)
+{
+    g_autofree char *homedir = NULL;
+    g_autoptr(GError) error = NULL;
+    int ret;
+
+    g_test_init (&argc, &argv, NULL);
+
+    homedir = g_dir_make_tmp ("seahorse-refresh-test-XXXXXX.d", &error);
+    g_assert_no_error (error);
+    seahorse_pgp_backend_initialize (homedir);
+
+    g_test_add_func ("/keyserver-refresh/filter", test_keyserver_refresh_filter);
+    g_test_add_func ("/keyserver-refresh/formatting", test_keyserver_refresh_formatting);
+    g_test_add_func ("/keyserver-refresh/updated", test_keyserver_refresh_updated);
+    g_test_add_func ("/keyserver-refresh/persist", test_keyserver_refresh_persist);
+
+    ret = g_test_run ();
+
+    g_rmdir (homedir);
+    return ret;
+}
@@ -0,0 +1,200 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "seahorse-ldap-entry.h"
+
+#include <glib.h>
+
+#include <string.h>
+
+/* Encodes the same SearchResultEntry body a server would send, from
+ * NULL-terminated attribute/value pairs */
+static struct berval *
+make_entry (const char *dn,
+            ...)
+{
+    BerElement *ber;
+    struct berval *bv = NULL;
+    const char *attr;
+    va_list va;
+
+    ber = ber_alloc_t (LBER_USE_DER);
+    g_assert_cmpint (ber_printf (ber, "{s{", dn), !=, -1);
+
+    va_start (va, dn);
+    while ((attr = va_arg (va, const char *)) != NULL) {
+        const char *value = va_arg (va, const char *);
+        g_assert_cmpint (ber_printf (ber, "{s[s]}", attr, value), !=, -1);
+    }
+    va_end (va);
+
+    g_assert_cmpint (ber_printf (ber, "}}"), !=, -1);
+    g_assert_cmpint (ber_flatten (ber, &bv), ==, 0);
+    ber_free (ber, 1);
+
+    return bv;
+}
+
+/* Decodes it like search_parse_key_from_ldap_entry() would */
+static gboolean
+decode_entry (BerElement          *ber,
+              struct berval       *bv,
+              SeahorseLDAPEntry   *entry)
+{
+    struct berval dn;
+
+    ber_init2 (ber, bv, LBER_USE_DER);
+    if (ber_scanf (ber, "{m{", &dn) == LBER_ERROR)
+        return FALSE;
+    return seahorse_ldap_entry_decode (entry, ber);
+}
+
+static void
+assert_berval (const struct berval *bv,
+               const char          *expected)
+{
+    g_assert_nonnull (bv->bv_val);
+    g_assert_cmpuint (bv->bv_len, ==, strlen (expected));
+    g_assert_cmpint (memcmp (bv->bv_val, expected, bv->bv_len), ==, 0);
+}
+
+static void
+test_ldap_entry_decode (void)
+{
+    BerElement *ber;
+    struct berval *bv;
+    SeahorseLDAPEntry entry;
+
+    bv = make_entry ("pgpCertID=0123456789ABCDEF,ou=PGP Keys,o=Example",
+                     "pgpCertID", "0123456789ABCDEF",
+                     "pgpUserID", "Alice <alice@example.org>",
+                     "pgpRevoked", "1",
+                     "pgpDisabled", "0",
+                     "pgpKeyCreateTime", "20200102030405Z",
+                     "pgpKeyExpireTime", "20300102030405Z",
+                     "pgpKeyType", "DSS/DH",
+                     "pgpKeySize", "4096",
+                     NULL);
+
+    ber = ber_alloc_t (LBER_USE_DER);
+    g_assert_true (decode_entry (ber, bv, &entry));
+
+    assert_berval (&entry.certid, "0123456789ABCDEF");
+    assert_berval (&entry.userid, "Alice <alice@example.org>");
+    g_assert_true (entry.revoked);
+    g_assert_false (entry.disabled);
+    g_assert_cmpint (entry.created, ==, 1577934245);
+    g_assert_cmpint (entry.expires, ==, 1893553445);
+    g_assert_cmpstr (entry.algo, ==, "Elgamal");
+    g_assert_cmpint (entry.length, ==, 4096);
+
+    ber_free (ber, 0);
+    ber_bvfree (bv);
+}
+
+static void
+test_ldap_entry_partial (void)
+{
+    BerElement *ber;
+    struct berval *bv;
+    SeahorseLDAPEntry entry;
+
+    /* Unknown attributes and bad values are skipped, missing ones stay 0 */
+    bv = make_entry ("pgpCertID=FEDCBA9876543210,o=Example",
+                     "objectClass", "pgpKeyInfo",
+                     "PGPCERTID", "FEDCBA9876543210",
+                     "pgpKeyCreateTime", "garbage",
+                     "pgpKeyType", "Unknown",
+                     NULL);
+
+    ber = ber_alloc_t (LBER_USE_DER);
+    g_assert_true (decode_entry (ber, bv, &entry));
+
+    assert_berval (&entry.certid, "FEDCBA9876543210");
+    g_assert_null (entry.userid.bv_val);
+    g_assert_false (entry.revoked);
+    g_assert_cmpint (entry.created, ==, 0);
+    g_assert_cmpint (entry.expires, ==, 0);
+    g_assert_null (entry.algo);
+    g_assert_cmpint (entry.length, ==, 0);
+
+    ber_free (ber, 0);
+    ber_bvfree (bv);
+}
+
+/* Run with -m perf */
+static void
+test_ldap_entry_benchmark (void)
+{
+    g_autoptr(GPtrArray) entries = NULL;
+    const unsigned int n_entries = 100000;
+    unsigned int n_decoded = 0;
+    BerElement *ber;
+    double elapsed;
+
+    entries = g_ptr_array_new_with_free_func ((GDestroyNotify) ber_bvfree);
+    for (unsigned int i = 0; i < n_entries; i++) {
+        g_autofree char *certid = g_strdup_printf ("%016X", i);
+        g_autofree char *dn = g_strdup_printf ("pgpCertID=%s,ou=PGP Keys,o=Example", certid);
+        g_autofree char *uid = g_strdup_printf ("User %u <user%u@example.org>", i, i);
+
+        g_ptr_array_add (entries,
+                         make_entry (dn,
+                                     "pgpCertID", certid,
+                                     "pgpUserID", uid,
+                                     "pgpRevoked", (i % 10) ? "0" : "1",
+                                     "pgpDisabled", "0",
+                                     "pgpKeyCreateTime", "20200102030405Z",
+                                     "pgpKeyExpireTime", "20300102030405Z",
+                                     "pgpKeyType", (i % 2) ? "RSA" : "DSA",
+                                     "pgpKeySize", "3072",
+                                     NULL));
+    }
+
+    ber = ber_alloc_t (LBER_USE_DER);
+
+    g_test_timer_start ();
+    for (unsigned int i = 0; i < entries->len; i++) {
+        SeahorseLDAPEntry entry;
+
+        if (decode_entry (ber, g_ptr_array_index (entries, i), &entry) &&
+            entry.certid.bv_val && entry.userid.bv_val)
+            n_decoded++;
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    ber_free (ber, 0);
+
+    g_assert_cmpuint (n_decoded, ==, n_entries);
+    g_test_minimized_result (elapsed, "Decoded %u entries in %.3f seconds",
+                             n_entries, elapsed);
+}
+
+int
+main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/ldap-entry/decode", test_ldap_entry_decode);
+    g_test_add_func ("/ldap-entry/partial", test_ldap_entry_partial);
+    if (g_test_perf ())
+        g_test_add_func ("/ldap-entry/benchmark", test_ldap_entry_benchmark);
+
+    return g_test_run ();
+}
@@ -20,8 +20,686 @@
 #include "seahorse-ldap-source.h"
 #include "seahorse-pgp-key.h"
 #include "seahorse-pgp-uid.h"
+#include "test-server-source-util.h"
 
 #include <glib.h>
+#include <gio/gio.h>
+
+#include <ldap.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A minimal LDAP key server, running in a thread of the test itself, so the
+ * source can be tested (and timed) without a real directory. It speaks just
+ * enough LDAPv3 for SeahorseLDAPSource: anonymous binds, searches with the
+ * filters we send (including paging) and adds.
+ */
+
+#define MOCK_BASE_DN        "ou=PGP Keys,o=Example"
+#define MOCK_KEY_ATTR       "pgpkeyv2"
+
+typedef struct {
+    char *certid;
+    char *uid;
+    char *data;
+} MockKey;
+
+typedef struct {
+    GSocketListener *listener;
+    GCancellable *cancellable;
+    guint16 port;
+    GThread *thread;
+
+    GMutex mutex;
+    GPtrArray *threads;         /* Of the connections */
+    GPtrArray *keys;            /* MockKey */
+    GHashTable *added;          /* Key data that was added → TRUE */
+    unsigned int n_connections;
+    unsigned int n_searches;
+    unsigned int n_adds;
+} MockServer;
+
+typedef struct {
+    MockServer *server;
+    GSocketConnection *connection;
+    BerElement *ber;
+    GByteArray *out;
+} MockConnection;
+
+static void
+mock_key_free (gpointer data)
+{
+    MockKey *key = data;
+    g_free (key->certid);
+    g_free (key->uid);
+    g_free (key->data);
+    g_free (key);
+}
+
+static void
+mock_server_seed (MockServer  *server,
+                  unsigned int n_keys)
+{
+    g_mutex_lock (&server->mutex);
+    for (unsigned int i = 0; i < n_keys; i++) {
+        MockKey *key = g_new0 (MockKey, 1);
+        unsigned int n = server->keys->len;
+
+        key->certid = g_strdup_printf ("%016X", n);
+        key->uid = g_strdup_printf ("User %u <user%u@example.org>", n, n);
+        key->data = test_make_key_data (n);
+        g_ptr_array_add (server->keys, key);
+    }
+    g_mutex_unlock (&server->mutex);
+}
+
+/* Filters */
+
+typedef struct _MockFilter MockFilter;
+
+struct _MockFilter {
+    ber_tag_t type;
+    char *attr;
+    char *value;                /* For equality */
+    char *initial;              /* For substrings */
+    GPtrArray *any;
+    char *final;
+    GPtrArray *children;        /* For and, or, not */
+};
+
+static void
+mock_filter_free (gpointer data)
+{
+    MockFilter *filter = data;
+    g_free (filter->attr);
+    g_free (filter->value);
+    g_free (filter->initial);
+    g_clear_pointer (&filter->any, g_ptr_array_unref);
+    g_free (filter->final);
+    g_clear_pointer (&filter->children, g_ptr_array_unref);
+    g_free (filter);
+}
+
+static char *
+berval_dup_down (const struct berval *bv)
+{
+    return g_ascii_strdown (bv->bv_val, bv->bv_len);
+}
+
+static MockFilter *
+mock_filter_parse (BerElement *ber)
+{
+    MockFilter *filter;
+    struct berval attr, value;
+    ber_tag_t tag;
+    ber_len_t len;
+    char *last;
+
+    filter = g_new0 (MockFilter, 1);
+    filter->type = ber_peek_tag (ber, &len);
+
+    switch (filter->type) {
+    case LDAP_FILTER_AND:
+    case LDAP_FILTER_OR:
+    case LDAP_FILTER_NOT:
+        filter->children = g_ptr_array_new_with_free_func (mock_filter_free);
+        for (tag = ber_first_element (ber, &len, &last);
+             tag != LBER_DEFAULT;
+             tag = ber_next_element (ber, &len, last)) {
+            MockFilter *child = mock_filter_parse (ber);
+            if (child == NULL)
+                goto fail;
+            g_ptr_array_add (filter->children, child);
+        }
+        break;
+    case LDAP_FILTER_EQUALITY:
+        if (ber_scanf (ber, "{mm}", &attr, &value) == LBER_ERROR)
+            goto fail;
+        filter->attr = berval_dup_down (&attr);
+        filter->value = berval_dup_down (&value);
+        break;
+    case LDAP_FILTER_SUBSTRINGS:
+        if (ber_scanf (ber, "{m", &attr) == LBER_ERROR)
+            goto fail;
+        filter->attr = berval_dup_down (&attr);
+        filter->any = g_ptr_array_new_with_free_func (g_free);
+        for (tag = ber_first_element (ber, &len, &last);
+             tag != LBER_DEFAULT;
+             tag = ber_next_element (ber, &len, last)) {
+            if (ber_scanf (ber, "m", &value) == LBER_ERROR)
+                goto fail;
+            if (tag == LDAP_SUBSTRING_INITIAL)
+                filter->initial = berval_dup_down (&value);
+            else if (tag == LDAP_SUBSTRING_FINAL)
+                filter->final = berval_dup_down (&value);
+            else
+                g_ptr_array_add (filter->any, berval_dup_down (&value));
+        }
+        break;
+    case LDAP_FILTER_PRESENT:
+        if (ber_scanf (ber, "m", &attr) == LBER_ERROR)
+            goto fail;
+        filter->attr = berval_dup_down (&attr);
+        break;
+    default:
+        goto fail;
+    }
+
+    return filter;
+
+fail:
+    mock_filter_free (filter);
+    return NULL;
+}
+
+static const char *
+mock_key_get_attribute (MockKey    *key,
+                        const char *attr)
+{
+    if (g_str_equal (attr, "pgpcertid"))
+        return key->certid;
+    if (g_str_equal (attr, "pgpuserid"))
+        return key->uid;
+    if (g_str_equal (attr, "objectclass"))
+        return "pgpKeyInfo";
+    return NULL;
+}
+
+static gboolean
+mock_filter_matches (MockFilter *filter,
+                     MockKey    *key)
+{
+    g_autofree char *value = NULL;
+    const char *attr_value;
+    const char *pos;
+
+    switch (filter->type) {
+    case LDAP_FILTER_AND:
+        for (unsigned int i = 0; i < filter->children->len; i++)
+            if (!mock_filter_matches (g_ptr_array_index (filter->children, i), key))
+                return FALSE;
+        return TRUE;
+    case LDAP_FILTER_OR:
+        for (unsigned int i = 0; i < filter->children->len; i++)
+            if (mock_filter_matches (g_ptr_array_index (filter->children, i), key))
+                return TRUE;
+        return FALSE;
+    case LDAP_FILTER_NOT:
+        return filter->children->len == 1 &&
+               !mock_filter_matches (g_ptr_array_index (filter->children, 0), key);
+    default:
+        break;
+    }
+
+    attr_value = mock_key_get_attribute (key, filter->attr);
+    if (attr_value == NULL)
+        return FALSE;
+    if (filter->type == LDAP_FILTER_PRESENT)
+        return TRUE;
+
+    value = g_ascii_strdown (attr_value, -1);
+    if (filter->type == LDAP_FILTER_EQUALITY)
+        return g_str_equal (value, filter->value);
+
+    /* Substrings */
+    if (filter->initial && !g_str_has_prefix (value, filter->initial))
+        return FALSE;
+    pos = value + (filter->initial ? strlen (filter->initial) : 0);
+    for (unsigned int i = 0; i < filter->any->len; i++) {
+        const char *any = g_ptr_array_index (filter->any, i);
+
+        pos = strstr (pos, any);
+        if (pos == NULL)
+            return FALSE;
+        pos += strlen (any);
+    }
+    return filter->final == NULL ||
+           (g_str_has_suffix (pos, filter->final));
+}
+
+/* Responses */
+
+static void
+mock_connection_queue (MockConnection *conn,
+                       BerElement     *ber)
+{
+    struct berval bv;
+
+    g_assert_cmpint (ber_flatten2 (ber, &bv, 0), ==, 0);
+    g_byte_array_append (conn->out, (guint8 *) bv.bv_val, bv.bv_len);
+    ber_free (ber, 1);
+}
+
+static void
+mock_connection_queue_result (MockConnection *conn,
+                              ber_int_t       msgid,
+                              ber_tag_t       type,
+                              ber_int_t       code,
+                              struct berval  *page_cookie)
+{
+    BerElement *ber = ber_alloc_t (LBER_USE_DER);
+
+    ber_printf (ber, "{it{ess}", msgid, type, code, "", "");
+
+    if (page_cookie != NULL) {
+        BerElement *value_ber = ber_alloc_t (LBER_USE_DER);
+        struct berval value;
+
+        ber_printf (value_ber, "{iO}", (ber_int_t) 0, page_cookie);
+        ber_flatten2 (value_ber, &value, 0);
+        ber_printf (ber, "t{{sO}}", (ber_tag_t) LDAP_TAG_CONTROLS,
+                    LDAP_CONTROL_PAGEDRESULTS, &value);
+        ber_free (value_ber, 1);
+    }
+
+    ber_printf (ber, "}");
+    mock_connection_queue (conn, ber);
+}
+
+static void
+mock_connection_queue_entry (MockConnection *conn,
+                             ber_int_t       msgid,
+                             const char     *dn,
+                             const char    **attrs)
+{
+    BerElement *ber = ber_alloc_t (LBER_USE_DER);
+
+    ber_printf (ber, "{it{s{", msgid, (ber_tag_t) LDAP_RES_SEARCH_ENTRY, dn);
+    for (unsigned int i = 0; attrs[i] != NULL; i += 2)
+        ber_printf (ber, "{s[s]}", attrs[i], attrs[i + 1]);
+    ber_printf (ber, "}}}");
+    mock_connection_queue (conn, ber);
+}
+
+/* Requests */
+
+static gboolean
+mock_connection_handle_search (MockConnection *conn,
+                               ber_int_t       msgid)
+{
+    MockServer *server = conn->server;
+    BerElement *ber = conn->ber;
+    g_autoptr(GArray) matches = NULL;
+    MockFilter *filter;
+    struct berval base, attr;
+    ber_int_t scope, deref, sizelimit, timelimit, attrsonly;
+    ber_int_t page_size = 0;
+    gboolean paged = FALSE;
+    gboolean with_data = FALSE;
+    unsigned int offset = 0;
+    unsigned int end;
+    ber_tag_t tag;
+    ber_len_t len;
+    char *last;
+
+    if (ber_scanf (ber, "{meeiib", &base, &scope, &deref,
+                   &sizelimit, &timelimit, &attrsonly) == LBER_ERROR)
+        return FALSE;
+
+    filter = mock_filter_parse (ber);
+    if (filter == NULL)
+        return FALSE;
+
+    for (tag = ber_first_element (ber, &len, &last);
+         tag != LBER_DEFAULT;
+         tag = ber_next_element (ber, &len, last)) {
+        if (ber_scanf (ber, "m", &attr) == LBER_ERROR)
+            break;
+        if (attr.bv_len == strlen (MOCK_KEY_ATTR) &&
+            g_ascii_strncasecmp (attr.bv_val, MOCK_KEY_ATTR, attr.bv_len) == 0)
+            with_data = TRUE;
+    }
+
+    /* The controls; we only know about paging */
+    if (ber_peek_tag (ber, &len) == LDAP_TAG_CONTROLS) {
+        for (tag = ber_first_element (ber, &len, &last);
+             tag != LBER_DEFAULT;
+             tag = ber_next_element (ber, &len, last)) {
+            struct berval oid, value = { 0, NULL };
+            ber_int_t critical;
+
+            if (ber_scanf (ber, "{m", &oid) == LBER_ERROR)
+                break;
+            if (ber_peek_tag (ber, &len) == LBER_BOOLEAN)
+                ber_scanf (ber, "b", &critical);
+            if (ber_peek_tag (ber, &len) == LBER_OCTETSTRING)
+                ber_scanf (ber, "m", &value);
+
+            if (value.bv_val != NULL &&
+                oid.bv_len == strlen (LDAP_CONTROL_PAGEDRESULTS) &&
+                strncmp (oid.bv_val, LDAP_CONTROL_PAGEDRESULTS, oid.bv_len) == 0) {
+                BerElement *value_ber = ber_init (&value);
+                struct berval cookie;
+
+                if (ber_scanf (value_ber, "{im}", &page_size, &cookie) != LBER_ERROR) {
+                    g_autofree char *str = g_strndup (cookie.bv_val, cookie.bv_len);
+                    paged = TRUE;
+                    offset = strtoul (str, NULL, 10);
+                }
+                ber_free (value_ber, 1);
+            }
+        }
+    }
+
+    g_mutex_lock (&server->mutex);
+    server->n_searches++;
+
+    if (base.bv_len == strlen ("cn=PGPServerInfo") &&
+        g_ascii_strncasecmp (base.bv_val, "cn=PGPServerInfo", base.bv_len) == 0) {
+        const char *attrs[] = {
+            "basekeyspacedn", MOCK_BASE_DN,
+            "version", "2",
+            NULL,
+        };
+        mock_connection_queue_entry (conn, msgid, "cn=PGPServerInfo", attrs);
+        mock_connection_queue_result (conn, msgid, LDAP_RES_SEARCH_RESULT,
+                                      LDAP_SUCCESS, NULL);
+        g_mutex_unlock (&server->mutex);
+        mock_filter_free (filter);
+        return TRUE;
+    }
+
+    matches = g_array_new (FALSE, FALSE, sizeof (unsigned int));
+    for (unsigned int i = 0; i < server->keys->len; i++) {
+        if (mock_filter_matches (filter, g_ptr_array_index (server->keys, i)))
+            g_array_append_val (matches, i);
+    }
+
+    end = matches->len;
+    if (paged && page_size > 0)
+        end = MIN (end, offset + page_size);
+
+    for (unsigned int i = offset; i < end; i++) {
+        MockKey *key = g_ptr_array_index (server->keys,
+                                          g_array_index (matches, unsigned int, i));
+        g_autofree char *dn = g_strdup_printf ("pgpCertID=%s,%s", key->certid, MOCK_BASE_DN);
+        const char *attrs[] = {
+            "pgpcertid", key->certid,
+            "pgpuserid", key->uid,
+            "pgprevoked", "0",
+            "pgpdisabled", "0",
+            "pgpkeycreatetime", "20200102030405Z",
+            "pgpkeytype", "RSA",
+            "pgpkeysize", "3072",
+            with_data ? MOCK_KEY_ATTR : NULL, key->data,
+            NULL,
+        };
+
+        mock_connection_queue_entry (conn, msgid, dn, attrs);
+    }
+
+    if (paged) {
+        g_autofree char *next = g_strdup_printf ("%u", end);
+        struct berval cookie = { 0, NULL };
+
+        if (end < matches->len) {
+            cookie.bv_val = next;
+            cookie.bv_len = strlen (next);
+        }
+        mock_connection_queue_result (conn, msgid, LDAP_RES_SEARCH_RESULT,
+                                      LDAP_SUCCESS, &cookie);
+    } else {
+        mock_connection_queue_result (conn, msgid, LDAP_RES_SEARCH_RESULT,
+                                      LDAP_SUCCESS, NULL);
+    }
+
+    g_mutex_unlock (&server->mutex);
+    mock_filter_free (filter);
+    return TRUE;
+}
+
+static gboolean
+mock_connection_handle_add (MockConnection *conn,
+                            ber_int_t       msgid)
+{
+    MockServer *server = conn->server;
+    BerElement *ber = conn->ber;
+    g_autofree char *data = NULL;
+    struct berval dn, attr, value;
+    ber_int_t code;
+    ber_len_t len;
+
+    if (ber_scanf (ber, "{m{", &dn) == LBER_ERROR)
+        return FALSE;
+
+    while (ber_peek_tag (ber, &len) == LBER_SEQUENCE) {
+        ber_tag_t tag;
+        char *last;
+
+        if (ber_scanf (ber, "{m", &attr) == LBER_ERROR)
+            return FALSE;
+        for (tag = ber_first_element (ber, &len, &last);
+             tag != LBER_DEFAULT;
+             tag = ber_next_element (ber, &len, last)) {
+            if (ber_scanf (ber, "m", &value) == LBER_ERROR)
+                return FALSE;
+            if (data == NULL &&
+                attr.bv_len == strlen (MOCK_KEY_ATTR) &&
+                g_ascii_strncasecmp (attr.bv_val, MOCK_KEY_ATTR, attr.bv_len) == 0)
+                data = g_strndup (value.bv_val, value.bv_len);
+        }
+    }
+
+    g_mutex_lock (&server->mutex);
+    server->n_adds++;
+    if (data == NULL)
+        code = LDAP_OBJECT_CLASS_VIOLATION;
+    else if (strstr (data, "rejected") != NULL)
+        code = LDAP_CONSTRAINT_VIOLATION;
+    else if (g_hash_table_contains (server->added, data))
+        code = LDAP_ALREADY_EXISTS;
+    else {
+        g_hash_table_add (server->added, g_steal_pointer (&data));
+        code = LDAP_SUCCESS;
+    }
+    g_mutex_unlock (&server->mutex);
+
+    mock_connection_queue_result (conn, msgid, LDAP_RES_ADD, code, NULL);
+    return TRUE;
+}
+
+/* Reads a single LDAPMessage: a SEQUENCE with a BER length */
+static GByteArray *
+mock_connection_read (MockConnection *conn)
+{
+    GInputStream *input = g_io_stream_get_input_stream (G_IO_STREAM (conn->connection));
+    GCancellable *cancellable = conn->server->cancellable;
+    g_autoptr(GByteArray) message = NULL;
+    guint8 header[6];
+    gsize n_read;
+    gsize n_length = 0;
+    gsize length;
+
+    if (!g_input_stream_read_all (input, header, 2, &n_read, cancellable, NULL) ||
+        n_read != 2 || header[0] != LBER_SEQUENCE)
+        return NULL;
+
+    length = header[1];
+    if (length & 0x80) {
+        n_length = length & 0x7f;
+        if (n_length == 0 || n_length > 4 ||
+            !g_input_stream_read_all (input, header + 2, n_length, &n_read, cancellable, NULL) ||
+            n_read != n_length)
+            return NULL;
+        length = 0;
+        for (gsize i = 0; i < n_length; i++)
+            length = (length << 8) | header[2 + i];
+    }
+
+    message = g_byte_array_sized_new (2 + n_length + length);
+    g_byte_array_append (message, header, 2 + n_length);
+    g_byte_array_set_size (message, 2 + n_length + length);
+    if (!g_input_stream_read_all (input, message->data + 2 + n_length, length,
+                                  &n_read, cancellable, NULL) ||
+        n_read != length)
+        return NULL;
+
+    return g_steal_pointer (&message);
+}
+
+static gpointer
+mock_connection_thread (gpointer user_data)
+{
+    MockConnection *conn = user_data;
+    GOutputStream *output = g_io_stream_get_output_stream (G_IO_STREAM (conn->connection));
+
+    for (;;) {
+        g_autoptr(GByteArray) message = NULL;
+        struct berval bv;
+        ber_int_t msgid;
+        ber_len_t len;
+        gboolean ok = TRUE;
+
+        message = mock_connection_read (conn);
+        if (message == NULL)
+            break;
+
+        bv.bv_val = (char *) message->data;
+        bv.bv_len = message->len;
+        ber_init2 (conn->ber, &bv, LBER_USE_DER);
+        if (ber_scanf (conn->ber, "{i", &msgid) == LBER_ERROR)
+            break;
+
+        switch (ber_peek_tag (conn->ber, &len)) {
+        case LDAP_REQ_BIND:
+            mock_connection_queue_result (conn, msgid, LDAP_RES_BIND, LDAP_SUCCESS, NULL);
+            break;
+        case LDAP_REQ_SEARCH:
+            ok = mock_connection_handle_search (conn, msgid);
+            break;
+        case LDAP_REQ_ADD:
+            ok = mock_connection_handle_add (conn, msgid);
+            break;
+        case LDAP_REQ_ABANDON:
+            break;
+        default:
+            /* Unbind, or something we don't know */
+            ok = FALSE;
+            break;
+        }
+
+        if (!ok)
+            break;
+
+        if (conn->out->len > 0) {
+            if (!g_output_stream_write_all (output, conn->out->data, conn->out->len,
+                                            NULL, conn->server->cancellable, NULL))
+                break;
+            g_byte_array_set_size (conn->out, 0);
+        }
+    }
+
+    g_io_stream_close (G_IO_STREAM (conn->connection), NULL, NULL);
+    g_object_unref (conn->connection);
+    ber_free (conn->ber, 0);
+    g_byte_array_unref (conn->out);
+    g_free (conn);
+    return NULL;
+}
+
+static gpointer
+mock_server_thread (gpointer user_data)
+{
+    MockServer *server = user_data;
+
+    for (;;) {
+        MockConnection *conn;
+        GSocketConnection *connection;
+
+        connection = g_socket_listener_accept (server->listener, NULL,
+                                               server->cancellable, NULL);
+        if (connection == NULL)
+            break;
+
+        conn = g_new0 (MockConnection, 1);
+        conn->server = server;
+        conn->connection = connection;
+        conn->ber = ber_alloc_t (LBER_USE_DER);
+        conn->out = g_byte_array_new ();
+
+        g_mutex_lock (&server->mutex);
+        server->n_connections++;
+        g_ptr_array_add (server->threads,
+                         g_thread_new ("mock-ldap-connection", mock_connection_thread, conn));
+        g_mutex_unlock (&server->mutex);
+    }
+
+    return NULL;
+}
+
+static MockServer *
+mock_server_start (void)
+{
+    MockServer *server;
+    g_autoptr(GInetAddress) loopback = NULL;
+    g_autoptr(GSocketAddress) address = NULL;
+    g_autoptr(GSocketAddress) effective = NULL;
+    g_autoptr(GError) error = NULL;
+
+    server = g_new0 (MockServer, 1);
+    g_mutex_init (&server->mutex);
+    server->cancellable = g_cancellable_new ();
+    server->threads = g_ptr_array_new ();
+    server->keys = g_ptr_array_new_with_free_func (mock_key_free);
+    server->added = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    loopback = g_inet_address_new_loopback (G_SOCKET_FAMILY_IPV4);
+    address = g_inet_socket_address_new (loopback, 0);
+    server->listener = g_socket_listener_new ();
+    g_socket_listener_add_address (server->listener, address,
+                                   G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP,
+                                   NULL, &effective, &error);
+    g_assert_no_error (error);
+    server->port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (effective));
+
+    server->thread = g_thread_new ("mock-ldap-server", mock_server_thread, server);
+    return server;
+}
+
+static void
+mock_server_stop (MockServer *server)
+{
+    g_cancellable_cancel (server->cancellable);
+    g_thread_join (server->thread);
+    g_socket_listener_close (server->listener);
+
+    for (unsigned int i = 0; i < server->threads->len; i++)
+        g_thread_join (g_ptr_array_index (server->threads, i));
+
+    g_ptr_array_unref (server->threads);
+    g_ptr_array_unref (server->keys);
+    g_hash_table_unref (server->added);
+    g_object_unref (server->listener);
+    g_object_unref (server->cancellable);
+    g_mutex_clear (&server->mutex);
+    g_free (server);
+}
+
+typedef struct {
+    MockServer *server;
+    SeahorseLDAPSource *source;
+} MockFixture;
+
+static void
+mock_fixture_setup (MockFixture  *fixture,
+                    gconstpointer user_data)
+{
+    g_autofree char *uri = NULL;
+
+    fixture->server = mock_server_start ();
+    uri = g_strdup_printf ("ldap://127.0.0.1:%u", fixture->server->port);
+    fixture->source = seahorse_ldap_source_new (uri);
+}
+
+static void
+mock_fixture_teardown (MockFixture  *fixture,
+                       gconstpointer user_data)
+{
+    /* This closes the pooled connections first */
+    g_clear_object (&fixture->source);
+    mock_server_stop (fixture->server);
+}
 
 static void
 test_ldap_is_valid_uri (void)
@@ -38,12 +716,181 @@ test_ldap_is_valid_uri (void)
     g_assert_false (seahorse_ldap_is_valid_uri ("hkp://keys.openpgp.org"));
 }
 
+static void
+test_ldap_page_size (void)
+{
+    g_autoptr(SeahorseLDAPSource) source = NULL;
+    unsigned int page_size;
+
+    source = seahorse_ldap_source_new ("ldap://keyserver.pgp.com");
+
+    /* Searches are paged by default */
+    g_assert_cmpuint (seahorse_ldap_source_get_page_size (source), >, 0);
+
+    g_object_set (source, "page-size", 0, NULL);
+    g_assert_cmpuint (seahorse_ldap_source_get_page_size (source), ==, 0);
+
+    seahorse_ldap_source_set_page_size (source, 500);
+    g_object_get (source, "page-size", &page_size, NULL);
+    g_assert_cmpuint (page_size, ==, 500);
+}
+
+static void
+test_ldap_search (MockFixture  *fixture,
+                  gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_autoptr(GcrSimpleCollection) results = NULL;
+    g_autoptr(GError) error = NULL;
+
+    mock_server_seed (fixture->server, 250);
+    seahorse_ldap_source_set_page_size (fixture->source, 4);
+
+    /* user7, user70 - user79: over several pages */
+    results = test_server_source_search (source, "user7@", &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (results)), ==, 1);
+
+    g_clear_object (&results);
+    results = test_server_source_search (source, "user7", &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (results)), ==, 11);
+
+    /* Server info once, then 1 + 3 pages; all over a single connection */
+    g_assert_cmpuint (fixture->server->n_searches, ==, 5);
+    g_assert_cmpuint (fixture->server->n_connections, ==, 1);
+}
+
+static void
+test_ldap_export (MockFixture  *fixture,
+                  gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_auto(GStrv) keyids = NULL;
+    g_autofree char *data = NULL;
+    g_autoptr(GError) error = NULL;
+
+    mock_server_seed (fixture->server, 200);
+
+    /* More than fits in a single batch */
+    keyids = test_make_keyids (50, 100, 16);
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (data);
+    g_assert_cmpuint (test_count_blocks (data), ==, 100);
+    g_assert_nonnull (strstr (data, "c3ludGhldGlj00000032"));
+    g_assert_null (strstr (data, "c3ludGhldGlj00000031"));
+
+    g_clear_pointer (&keyids, g_strfreev);
+    g_clear_pointer (&data, g_free);
+
+    /* Keys the server doesn't have are just missing */
+    keyids = test_make_keyids (190, 20, 16);
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, 10);
+
+    g_assert_cmpuint (fixture->server->n_connections, ==, 1);
+}
+
+static void
+test_ldap_import (MockFixture  *fixture,
+                  gconstpointer user_data)
+{
+    SeahorseServerSource *source = SEAHORSE_SERVER_SOURCE (fixture->source);
+    g_autoptr(GError) error = NULL;
+    g_autofree char *armor = NULL;
+    g_autofree char *rejected = NULL;
+    g_autofree char *accepted = NULL;
+    g_autofree char *both = NULL;
+
+    armor = test_make_armor (0, 40, "YWNjZXB0ZWQ");
+    g_assert_true (test_server_source_import (source, armor, &error));
+    g_assert_no_error (error);
+    g_assert_cmpuint (g_hash_table_size (fixture->server->added), ==, 40);
+
+    /* Keys that are already there aren't an error */
+    g_assert_true (test_server_source_import (source, armor, &error));
+    g_assert_no_error (error);
+
+    /* But the ones the server refuses are, without stopping the others */
+    rejected = test_make_armor (0, 2, "rejected");
+    accepted = test_make_armor (40, 8, "YWNjZXB0ZWQ");
+    both = g_strconcat (rejected, accepted, NULL);
+    g_assert_false (test_server_source_import (source, both, &error));
+    g_assert_nonnull (error);
+    g_assert_nonnull (strstr (error->message, "2 keys out of 10"));
+    g_assert_cmpuint (g_hash_table_size (fixture->server->added), ==, 48);
+
+    g_assert_cmpuint (fixture->server->n_adds, ==, 90);
+}
+
+/* Run with -m perf */
+#define BENCHMARK_KEYS 20000
+
+static void
+test_ldap_benchmark_search (MockFixture  *fixture,
+                            gconstpointer user_data)
+{
+    double elapsed;
+
+    mock_server_seed (fixture->server, BENCHMARK_KEYS);
+
+    elapsed = test_server_source_time_search (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              "example.org", BENCHMARK_KEYS);
+    g_test_minimized_result (elapsed, "Found %u keys in %.3f seconds",
+                             BENCHMARK_KEYS, elapsed);
+}
+
+static void
+test_ldap_benchmark_export (MockFixture  *fixture,
+                            gconstpointer user_data)
+{
+    double elapsed;
+
+    mock_server_seed (fixture->server, BENCHMARK_KEYS);
+
+    elapsed = test_server_source_time_export (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              BENCHMARK_KEYS / 4, 16);
+    g_test_minimized_result (elapsed, "Exported %u keys in %.3f seconds",
+                             BENCHMARK_KEYS / 4, elapsed);
+}
+
+static void
+test_ldap_benchmark_import (MockFixture  *fixture,
+                            gconstpointer user_data)
+{
+    double elapsed;
+
+    elapsed = test_server_source_time_import (SEAHORSE_SERVER_SOURCE (fixture->source),
+                                              BENCHMARK_KEYS / 4);
+    g_assert_cmpuint (g_hash_table_size (fixture->server->added), ==, BENCHMARK_KEYS / 4);
+    g_test_minimized_result (elapsed, "Imported %u keys in %.3f seconds",
+                             BENCHMARK_KEYS / 4, elapsed);
+}
+
 int
 main (int argc, char **argv)
 {
     g_test_init (&argc, &argv, NULL);
 
     g_test_add_func ("/ldap/valid-uri", test_ldap_is_valid_uri);
+    g_test_add_func ("/ldap/page-size", test_ldap_page_size);
+    g_test_add ("/ldap/search", MockFixture, NULL,
+                mock_fixture_setup, test_ldap_search, mock_fixture_teardown);
+    g_test_add ("/ldap/export", MockFixture, NULL,
+                mock_fixture_setup, test_ldap_export, mock_fixture_teardown);
+    g_test_add ("/ldap/import", MockFixture, NULL,
+                mock_fixture_setup, test_ldap_import, mock_fixture_teardown);
+
+    if (g_test_perf ()) {
+        g_test_add ("/ldap/benchmark/search", MockFixture, NULL,
+                    mock_fixture_setup, test_ldap_benchmark_search, mock_fixture_teardown);
+        g_test_add ("/ldap/benchmark/export", MockFixture, NULL,
+                    mock_fixture_setup, test_ldap_benchmark_export, mock_fixture_teardown);
+        g_test_add ("/ldap/benchmark/import", MockFixture, NULL,
+                    mock_fixture_setup, test_ldap_benchmark_import, mock_fixture_teardown);
+    }
 
     return g_test_run ();
 }
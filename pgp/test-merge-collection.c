@@ -0,0 +1,159 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "seahorse-merge-collection.h"
+#include "seahorse-pgp-subkey.h"
+#include "seahorse-pgp-uid.h"
+
+#include <glib.h>
+#include <string.h>
+
+static SeahorsePgpKey *
+make_key (const char *fingerprint,
+          const char *uid_string)
+{
+    g_autoptr(SeahorsePgpSubkey) subkey = NULL;
+    g_autoptr(SeahorsePgpUid) uid = NULL;
+    SeahorsePgpKey *key;
+    size_t len = strlen (fingerprint);
+
+    key = seahorse_pgp_key_new ();
+
+    subkey = seahorse_pgp_subkey_new ();
+    seahorse_pgp_subkey_set_fingerprint (subkey, fingerprint);
+    seahorse_pgp_subkey_set_keyid (subkey, len > 16 ? fingerprint + len - 16 : fingerprint);
+    seahorse_pgp_key_add_subkey (key, subkey);
+
+    uid = seahorse_pgp_uid_new (key, uid_string);
+    seahorse_pgp_key_add_uid (key, uid);
+
+    return key;
+}
+
+static char *
+make_fingerprint (unsigned int n)
+{
+    return g_strdup_printf ("%040X", n);
+}
+
+static void
+test_merge_collection_merge (void)
+{
+    g_autoptr(GcrSimpleCollection) collection = NULL;
+    g_autoptr(SeahorsePgpKey) first = NULL;
+    g_autoptr(SeahorsePgpKey) second = NULL;
+    g_autoptr(SeahorsePgpKey) ldap = NULL;
+    g_autoptr(SeahorsePgpKey) other = NULL;
+    SeahorseMergeCollection *merge;
+    SeahorsePgpKey *added, *merged;
+
+    collection = seahorse_merge_collection_new ();
+    merge = SEAHORSE_MERGE_COLLECTION (collection);
+
+    first = make_key ("0123456789ABCDEF0123456789ABCDEF01234567",
+                      "Alice <alice@example.org>");
+    /* Another server, with other formatting and an extra UID */
+    second = make_key ("0123 4567 89ab cdef 0123 4567 89ab cdef 0123 4567",
+                       "Alice <alice@example.org>");
+    {
+        g_autoptr(SeahorsePgpUid) uid = NULL;
+
+        uid = seahorse_pgp_uid_new (second, "Alice <alice@work.example.org>");
+        seahorse_pgp_key_add_uid (second, uid);
+    }
+    /* An LDAP server only has the long key ID */
+    ldap = make_key ("89ABCDEF01234567", "Alice <alice@home.example.org>");
+    other = make_key ("FEDCBA9876543210FEDCBA9876543210FEDCBA98",
+                      "Bob <bob@example.org>");
+
+    added = seahorse_merge_collection_add_key (merge, first);
+    g_assert_true (added == first);
+    merged = seahorse_merge_collection_add_key (merge, second);
+    g_assert_true (merged != first && merged != second);
+    added = seahorse_merge_collection_add_key (merge, ldap);
+    g_assert_true (added == merged);
+    added = seahorse_merge_collection_add_key (merge, other);
+    g_assert_true (added == other);
+
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (collection)), ==, 2);
+    g_assert_false (gcr_collection_contains (GCR_COLLECTION (collection), G_OBJECT (first)));
+    g_assert_false (gcr_collection_contains (GCR_COLLECTION (collection), G_OBJECT (second)));
+
+    /* The UIDs are merged, without duplicates */
+    g_assert_cmpuint (g_list_model_get_n_items (seahorse_pgp_key_get_uids (merged)), ==, 3);
+    g_assert_cmpuint (g_list_model_get_n_items (seahorse_pgp_key_get_subkeys (merged)), ==, 1);
+
+    /* But the keys that were merged are left untouched */
+    g_assert_cmpuint (g_list_model_get_n_items (seahorse_pgp_key_get_uids (first)), ==, 1);
+    g_assert_cmpuint (g_list_model_get_n_items (seahorse_pgp_key_get_uids (second)), ==, 2);
+
+    g_assert_true (seahorse_merge_collection_lookup (merge, "0123456789abcdef0123456789abcdef01234567") == merged);
+    g_assert_true (seahorse_merge_collection_lookup (merge, "fedcba9876543210fedcba9876543210fedcba98") == other);
+
+    /* Removing a key drops it from the index */
+    gcr_simple_collection_remove (collection, G_OBJECT (other));
+    g_assert_null (seahorse_merge_collection_lookup (merge, "FEDCBA9876543210FEDCBA9876543210FEDCBA98"));
+}
+
+/* Run with -m perf */
+static void
+test_merge_collection_benchmark (void)
+{
+    g_autoptr(GcrSimpleCollection) collection = NULL;
+    g_autoptr(GPtrArray) results = NULL;
+    const unsigned int n_results = 50000;
+    const unsigned int n_unique = n_results / 2;
+    double elapsed;
+
+    /* Half of the results come from a second server, with an extra UID on
+     * every other key */
+    results = g_ptr_array_new_with_free_func (g_object_unref);
+    for (unsigned int i = 0; i < n_results; i++) {
+        g_autofree char *fingerprint = make_fingerprint (i % n_unique);
+        g_autofree char *uid = g_strdup_printf ("User %u <user%u@example.org>",
+                                                i % n_unique,
+                                                (i < n_unique || i % 2) ? i % n_unique : i);
+
+        g_ptr_array_add (results, make_key (fingerprint, uid));
+    }
+
+    collection = seahorse_merge_collection_new ();
+
+    g_test_timer_start ();
+    for (unsigned int i = 0; i < results->len; i++)
+        seahorse_merge_collection_add_key (SEAHORSE_MERGE_COLLECTION (collection),
+                                           g_ptr_array_index (results, i));
+    elapsed = g_test_timer_elapsed ();
+
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (collection)), ==, n_unique);
+    g_test_minimized_result (elapsed, "Merged %u results into %u keys in %.3f seconds",
+                             n_results, n_unique, elapsed);
+}
+
+int
+main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/merge-collection/merge", test_merge_collection_merge);
+    if (g_test_perf ())
+        g_test_add_func ("/merge-collection/benchmark", test_merge_collection_benchmark);
+
+    return g_test_run ();
+}
@@ -0,0 +1,177 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "seahorse-search-cache.h"
+#include "seahorse-pgp-key.h"
+
+#include <glib.h>
+
+static GPtrArray *
+make_keys (unsigned int n_keys)
+{
+    GPtrArray *keys;
+
+    keys = g_ptr_array_new_with_free_func (g_object_unref);
+    for (unsigned int i = 0; i < n_keys; i++)
+        g_ptr_array_add (keys, seahorse_pgp_key_new ());
+    return keys;
+}
+
+static void
+test_search_cache_normalize_query (void)
+{
+    g_autofree char *normalized = NULL;
+
+    normalized = seahorse_search_cache_normalize_query ("  Niels   De\tGraef ");
+    g_assert_cmpstr (normalized, ==, "niels de graef");
+}
+
+static void
+test_search_cache_hit (void)
+{
+    g_autoptr(SeahorseSearchCache) cache = NULL;
+    g_autoptr(GPtrArray) keys = NULL;
+    g_autoptr(GPtrArray) cached = NULL;
+    gboolean refresh = TRUE;
+
+    cache = seahorse_search_cache_new (8, G_MAXSIZE, G_TIME_SPAN_HOUR);
+    keys = make_keys (3);
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "Alice", keys);
+
+    /* Differently formatted, but equal queries hit */
+    cached = seahorse_search_cache_lookup (cache, "HKP://keys.example.org",
+                                           " alice ", &refresh);
+    g_assert_nonnull (cached);
+    g_assert_cmpuint (cached->len, ==, 3);
+    g_assert_true (g_ptr_array_index (cached, 0) == g_ptr_array_index (keys, 0));
+    g_assert_false (refresh);
+
+    /* But other servers don't */
+    g_clear_pointer (&cached, g_ptr_array_unref);
+    cached = seahorse_search_cache_lookup (cache, "hkp://other.example.org",
+                                           "alice", NULL);
+    g_assert_null (cached);
+
+    seahorse_search_cache_invalidate (cache, "hkp://keys.example.org", "alice");
+    g_assert_cmpuint (seahorse_search_cache_get_n_entries (cache), ==, 0);
+    g_assert_cmpuint (seahorse_search_cache_get_size (cache), ==, 0);
+}
+
+static void
+test_search_cache_expiry (void)
+{
+    g_autoptr(SeahorseSearchCache) cache = NULL;
+    g_autoptr(GPtrArray) keys = NULL;
+    g_autoptr(GPtrArray) cached = NULL;
+    gboolean refresh = FALSE;
+
+    cache = seahorse_search_cache_new (8, G_MAXSIZE, 200 * G_TIME_SPAN_MILLISECOND);
+    keys = make_keys (1);
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "bob", keys);
+
+    /* After half of the TTL, only the first lookup asks for a refresh */
+    g_usleep (120 * G_TIME_SPAN_MILLISECOND);
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org",
+                                           "bob", &refresh);
+    g_assert_nonnull (cached);
+    g_assert_true (refresh);
+
+    g_clear_pointer (&cached, g_ptr_array_unref);
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org",
+                                           "bob", &refresh);
+    g_assert_nonnull (cached);
+    g_assert_false (refresh);
+
+    /* And after the TTL, the entry is gone */
+    g_usleep (120 * G_TIME_SPAN_MILLISECOND);
+    g_clear_pointer (&cached, g_ptr_array_unref);
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org",
+                                           "bob", &refresh);
+    g_assert_null (cached);
+    g_assert_cmpuint (seahorse_search_cache_get_n_entries (cache), ==, 0);
+}
+
+static void
+test_search_cache_lru (void)
+{
+    g_autoptr(SeahorseSearchCache) cache = NULL;
+    g_autoptr(GPtrArray) keys = NULL;
+    g_autoptr(GPtrArray) cached = NULL;
+
+    cache = seahorse_search_cache_new (2, G_MAXSIZE, G_TIME_SPAN_HOUR);
+    keys = make_keys (1);
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "one", keys);
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "two", keys);
+
+    /* Touch "one", so "two" is the least recently used one */
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org", "one", NULL);
+    g_assert_nonnull (cached);
+    g_clear_pointer (&cached, g_ptr_array_unref);
+
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "three", keys);
+    g_assert_cmpuint (seahorse_search_cache_get_n_entries (cache), ==, 2);
+
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org", "two", NULL);
+    g_assert_null (cached);
+    cached = seahorse_search_cache_lookup (cache, "hkp://keys.example.org", "one", NULL);
+    g_assert_nonnull (cached);
+}
+
+static void
+test_search_cache_size_limit (void)
+{
+    g_autoptr(SeahorseSearchCache) cache = NULL;
+    g_autoptr(GPtrArray) small = NULL;
+    g_autoptr(GPtrArray) large = NULL;
+    gsize small_size;
+
+    cache = seahorse_search_cache_new (100, 16 * 1024, G_TIME_SPAN_HOUR);
+    small = make_keys (2);
+    large = make_keys (100);
+
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "small", small);
+    small_size = seahorse_search_cache_get_size (cache);
+    g_assert_cmpuint (small_size, >, 0);
+
+    /* Results that don't fit at all aren't cached, and don't evict others */
+    seahorse_search_cache_store (cache, "hkp://keys.example.org", "large", large);
+    g_assert_cmpuint (seahorse_search_cache_get_n_entries (cache), ==, 1);
+    g_assert_cmpuint (seahorse_search_cache_get_size (cache), ==, small_size);
+
+    /* Entries are evicted until the total size fits again */
+    for (unsigned int i = 0; i < 20; i++) {
+        g_autofree char *query = g_strdup_printf ("query %u", i);
+        seahorse_search_cache_store (cache, "hkp://keys.example.org", query, small);
+        g_assert_cmpuint (seahorse_search_cache_get_size (cache), <=, 16 * 1024);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/search-cache/normalize-query", test_search_cache_normalize_query);
+    g_test_add_func ("/search-cache/hit", test_search_cache_hit);
+    g_test_add_func ("/search-cache/expiry", test_search_cache_expiry);
+    g_test_add_func ("/search-cache/lru", test_search_cache_lru);
+    g_test_add_func ("/search-cache/size-limit", test_search_cache_size_limit);
+
+    return g_test_run ();
+}
@@ -0,0 +1,216 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "test-server-source-util.h"
+
+#include <glib.h>
+#include <gio/gio.h>
+
+#include <string.h>
+
+/**
+ * test_make_key_data:
+ * @n: The number of the key
+ *
+ * Returns: (transfer full): The key block a mock server has for key @n
+ */
+char *
+test_make_key_data (unsigned int n)
+{
+    return g_strdup_printf ("-----BEGIN PGP PUBLIC KEY BLOCK-----\n\n"
+                            "c3ludGhldGlj%08X\n"
+                            "-----END PGP PUBLIC KEY BLOCK-----", n);
+}
+
+/**
+ * test_make_armor:
+ * @first: The number of the first key
+ * @n_keys: The amount of keys
+ * @content: What the key data starts with (mock servers reject "rejected")
+ *
+ * Returns: (transfer full): Key blocks to send to a server
+ */
+char *
+test_make_armor (unsigned int first,
+                 unsigned int n_keys,
+                 const char  *content)
+{
+    GString *armor = g_string_new (NULL);
+
+    for (unsigned int i = first; i < first + n_keys; i++)
+        g_string_append_printf (armor,
+                                "-----BEGIN PGP PUBLIC KEY BLOCK-----\n\n"
+                                "%s%08X\n"
+                                "-----END PGP PUBLIC KEY BLOCK-----\n",
+                                content, i);
+    return g_string_free (armor, FALSE);
+}
+
+/**
+ * test_make_keyids:
+ * @first: The number of the first key
+ * @n_keys: The amount of keys
+ * @n_digits: 16 for key IDs, 40 for fingerprints
+ *
+ * Returns: (transfer full): The key IDs of the keys, which are their numbers
+ */
+GStrv
+test_make_keyids (unsigned int first,
+                  unsigned int n_keys,
+                  unsigned int n_digits)
+{
+    GPtrArray *keyids = g_ptr_array_new ();
+
+    for (unsigned int i = first; i < first + n_keys; i++)
+        g_ptr_array_add (keyids, g_strdup_printf ("%0*X", n_digits, i));
+    g_ptr_array_add (keyids, NULL);
+    return (GStrv) g_ptr_array_free (keyids, FALSE);
+}
+
+unsigned int
+test_count_blocks (const char *data)
+{
+    unsigned int count = 0;
+
+    for (const char *p = data; (p = strstr (p, "-----BEGIN PGP")) != NULL; p++)
+        count++;
+    return count;
+}
+
+static void
+on_async_ready (GObject      *source,
+                GAsyncResult *result,
+                gpointer      user_data)
+{
+    GAsyncResult **ret = user_data;
+    *ret = g_object_ref (result);
+}
+
+static GAsyncResult *
+wait_for_result (GAsyncResult **result)
+{
+    while (*result == NULL)
+        g_main_context_iteration (NULL, TRUE);
+    return *result;
+}
+
+GcrSimpleCollection *
+test_server_source_search (SeahorseServerSource *source,
+                           const char           *match,
+                           GError              **error)
+{
+    g_autoptr(GcrSimpleCollection) results = NULL;
+    g_autoptr(GAsyncResult) result = NULL;
+
+    results = GCR_SIMPLE_COLLECTION (gcr_simple_collection_new ());
+    seahorse_server_source_search_async (source, match, results, NULL,
+                                         on_async_ready, &result);
+    if (!seahorse_server_source_search_finish (source, wait_for_result (&result), error))
+        return NULL;
+    return g_steal_pointer (&results);
+}
+
+char *
+test_server_source_export (SeahorseServerSource *source,
+                           const char          **keyids,
+                           GError              **error)
+{
+    g_autoptr(GAsyncResult) result = NULL;
+    gsize size;
+
+    seahorse_server_source_export_async (source, keyids, NULL, on_async_ready, &result);
+    return seahorse_server_source_export_finish (source, wait_for_result (&result),
+                                                 &size, error);
+}
+
+gboolean
+test_server_source_import (SeahorseServerSource *source,
+                           const char           *armor,
+                           GError              **error)
+{
+    g_autoptr(GAsyncResult) result = NULL;
+    g_autoptr(GInputStream) input = NULL;
+    GList *keys;
+
+    input = g_memory_input_stream_new_from_data (g_strdup (armor), -1, g_free);
+    seahorse_server_source_import_async (source, input, NULL, on_async_ready, &result);
+    keys = seahorse_server_source_import_finish (source, wait_for_result (&result), error);
+    g_list_free_full (keys, g_object_unref);
+    return error == NULL || *error == NULL;
+}
+
+/* The timed operations of the benchmarks, which check they got everything
+ * and return the seconds it took */
+
+double
+test_server_source_time_search (SeahorseServerSource *source,
+                                const char           *match,
+                                unsigned int          n_expected)
+{
+    g_autoptr(GcrSimpleCollection) results = NULL;
+    g_autoptr(GError) error = NULL;
+    double elapsed;
+
+    g_test_timer_start ();
+    results = test_server_source_search (source, match, &error);
+    elapsed = g_test_timer_elapsed ();
+
+    g_assert_no_error (error);
+    g_assert_cmpuint (gcr_collection_get_length (GCR_COLLECTION (results)), ==, n_expected);
+    return elapsed;
+}
+
+double
+test_server_source_time_export (SeahorseServerSource *source,
+                                unsigned int          n_keys,
+                                unsigned int          n_digits)
+{
+    g_auto(GStrv) keyids = NULL;
+    g_autofree char *data = NULL;
+    g_autoptr(GError) error = NULL;
+    double elapsed;
+
+    keyids = test_make_keyids (0, n_keys, n_digits);
+
+    g_test_timer_start ();
+    data = test_server_source_export (source, (const char **) keyids, &error);
+    elapsed = g_test_timer_elapsed ();
+
+    g_assert_no_error (error);
+    g_assert_cmpuint (test_count_blocks (data), ==, n_keys);
+    return elapsed;
+}
+
+double
+test_server_source_time_import (SeahorseServerSource *source,
+                                unsigned int          n_keys)
+{
+    g_autofree char *armor = NULL;
+    g_autoptr(GError) error = NULL;
+    double elapsed;
+
+    armor = test_make_armor (0, n_keys, "YWNjZXB0ZWQ");
+
+    g_test_timer_start ();
+    test_server_source_import (source, armor, &error);
+    elapsed = g_test_timer_elapsed ();
+
+    g_assert_no_error (error);
+    return elapsed;
+}
@@ -0,0 +1,64 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Helpers for testing a SeahorseServerSource against a mock key server,
+ * whatever its protocol. The mock servers themselves live in the tests.
+ */
+
+#pragma once
+
+#include "seahorse-server-source.h"
+
+#include <gcr/gcr.h>
+
+char *                test_make_key_data                (unsigned int n);
+
+char *                test_make_armor                   (unsigned int first,
+                                                         unsigned int n_keys,
+                                                         const char  *content);
+
+GStrv                 test_make_keyids                  (unsigned int first,
+                                                         unsigned int n_keys,
+                                                         unsigned int n_digits);
+
+unsigned int          test_count_blocks                 (const char *data);
+
+GcrSimpleCollection * test_server_source_search         (SeahorseServerSource *source,
+                                                         const char           *match,
+                                                         GError              **error);
+
+char *                test_server_source_export         (SeahorseServerSource *source,
+                                                         const char          **keyids,
+                                                         GError              **error);
+
+gboolean              test_server_source_import         (SeahorseServerSource *source,
+                                                         const char           *armor,
+                                                         GError              **error);
+
+double                test_server_source_time_search    (SeahorseServerSource *source,
+                                                         const char           *match,
+                                                         unsigned int          n_expected);
+
+double                test_server_source_time_export    (SeahorseServerSource *source,
+                                                         unsigned int          n_keys,
+                                                         unsigned int          n_digits);
+
+double                test_server_source_time_import    (SeahorseServerSource *source,
+                                                         unsigned int          n_keys);
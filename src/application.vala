@@ -109,6 +109,7 @@ public class Seahorse.Application : Gtk.Application {
         Ssh.Backend.initialize();
 #if WITH_PGP
         Pgp.Backend.initialize(null);
+        Pgp.Backend.get().start_background_refresh();
 #endif
 #if WITH_PKCS11
         Pkcs11.Backend.initialize();
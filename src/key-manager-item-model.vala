@@ -0,0 +1,224 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Shows the items of a {@link GLib.ListModel} (i.e. the {@link ItemList}) as
+ * a flat {@link Gtk.TreeModel}, so they can be used in a {@link Gtk.TreeView}.
+ *
+ * The only column holds the item itself. When the items change, the rows are
+ * only updated in update_changed_rows(), so a lot of changes in a short while
+ * (like a keyring that's refreshed) can be handled together.
+ */
+public class Seahorse.KeyManagerItemModel : GLib.Object, Gtk.TreeModel {
+
+    public GLib.ListModel items { get; construct; }
+
+    // Iters don't survive a change of the list
+    private int stamp;
+
+    /** The items that were asked for, and are watched for changes */
+    private GLib.HashTable<unowned GLib.Object, unowned GLib.Object> watched
+        = new GLib.HashTable<unowned GLib.Object, unowned GLib.Object>(GLib.direct_hash, GLib.direct_equal);
+
+    /** The items that changed since the last update of their rows */
+    private GLib.GenericSet<unowned GLib.Object> changed
+        = new GLib.GenericSet<unowned GLib.Object>(GLib.direct_hash, GLib.direct_equal);
+
+    /**
+     * Emitted when an item changes, and there were no changes yet that are
+     * waiting for update_changed_rows()
+     */
+    public signal void changes_pending();
+
+    construct {
+        this.stamp = (int) GLib.Random.next_int();
+        this.items.items_changed.connect(on_items_changed);
+    }
+
+    public KeyManagerItemModel(GLib.ListModel items) {
+        GLib.Object(items: items);
+    }
+
+    ~KeyManagerItemModel() {
+        this.items.items_changed.disconnect(on_items_changed);
+
+        foreach (unowned GLib.Object item in this.watched.get_keys()) {
+            item.notify.disconnect(on_item_notify);
+            item.weak_unref(on_item_finalized);
+        }
+    }
+
+    /** Returns the item of the row that @iter points to */
+    public GLib.Object? get_object(Gtk.TreeIter iter) {
+        return_val_if_fail(iter.stamp == this.stamp, null);
+
+        var item = this.items.get_item(iter_index(iter));
+        if (item != null)
+            watch_item(item);
+        return item;
+    }
+
+    private void on_items_changed(uint position, uint removed, uint added) {
+        this.stamp++;
+
+        // The list already changed, but a tree view wants to hear about
+        // every row separately
+        var path = new Gtk.TreePath();
+        path.append_index((int) position);
+        for (uint i = 0; i < removed; i++)
+            row_deleted(path);
+
+        for (uint i = 0; i < added; i++) {
+            Gtk.TreeIter iter;
+            make_iter(out iter, position + i);
+            row_inserted(path, iter);
+            path.next();
+        }
+    }
+
+    private void watch_item(GLib.Object item) {
+        if (this.watched.contains(item))
+            return;
+
+        this.watched.add(item);
+        item.notify.connect(on_item_notify);
+        item.weak_ref(on_item_finalized);
+    }
+
+    private void on_item_finalized(GLib.Object item) {
+        this.watched.remove(item);
+        this.changed.remove(item);
+    }
+
+    private void on_item_notify(GLib.Object item, GLib.ParamSpec pspec) {
+        if (this.changed.contains(item))
+            return;
+
+        this.changed.add(item);
+        if (this.changed.length == 1)
+            changes_pending();
+    }
+
+    /**
+     * Updates the rows of all items that changed since the last time, each
+     * row only once.
+     */
+    public void update_changed_rows() {
+        // Finding the rows means walking the list, so that's done only once
+        // for all of them
+        uint n_left = this.changed.length;
+        uint n_items = this.items.get_n_items();
+        for (uint i = 0; i < n_items && n_left > 0; i++) {
+            var item = this.items.get_item(i);
+            if (!this.changed.contains(item))
+                continue;
+
+            var path = new Gtk.TreePath();
+            path.append_index((int) i);
+            Gtk.TreeIter iter;
+            make_iter(out iter, i);
+            row_changed(path, iter);
+            n_left--;
+        }
+        this.changed.remove_all();
+    }
+
+    private static uint iter_index(Gtk.TreeIter iter) {
+        return (uint) (ulong) iter.user_data;
+    }
+
+    private bool make_iter(out Gtk.TreeIter iter, uint index) {
+        iter = Gtk.TreeIter();
+        if (index >= this.items.get_n_items())
+            return false;
+
+        iter.stamp = this.stamp;
+        iter.user_data = (void*) (ulong) index;
+        return true;
+    }
+
+    public Gtk.TreeModelFlags get_flags() {
+        return Gtk.TreeModelFlags.LIST_ONLY;
+    }
+
+    public int get_n_columns() {
+        return 1;
+    }
+
+    public GLib.Type get_column_type(int index) {
+        return typeof(GLib.Object);
+    }
+
+    public bool get_iter(out Gtk.TreeIter iter, Gtk.TreePath path) {
+        unowned int[] indices = path.get_indices_with_depth();
+        if (indices.length != 1 || indices[0] < 0) {
+            iter = Gtk.TreeIter();
+            return false;
+        }
+
+        return make_iter(out iter, indices[0]);
+    }
+
+    public Gtk.TreePath? get_path(Gtk.TreeIter iter) {
+        return_val_if_fail(iter.stamp == this.stamp, null);
+
+        var path = new Gtk.TreePath();
+        path.append_index((int) iter_index(iter));
+        return path;
+    }
+
+    public void get_value(Gtk.TreeIter iter, int column, out GLib.Value value) {
+        value = GLib.Value(typeof(GLib.Object));
+        value.set_object(get_object(iter));
+    }
+
+    public bool iter_next(ref Gtk.TreeIter iter) {
+        return_val_if_fail(iter.stamp == this.stamp, false);
+
+        uint next = iter_index(iter) + 1;
+        return make_iter(out iter, next);
+    }
+
+    public bool iter_children(out Gtk.TreeIter iter, Gtk.TreeIter? parent) {
+        return iter_nth_child(out iter, parent, 0);
+    }
+
+    public bool iter_has_child(Gtk.TreeIter iter) {
+        return false;
+    }
+
+    public int iter_n_children(Gtk.TreeIter? iter) {
+        return (iter == null)? (int) this.items.get_n_items() : 0;
+    }
+
+    public bool iter_nth_child(out Gtk.TreeIter iter, Gtk.TreeIter? parent, int n) {
+        if (parent != null || n < 0) {
+            iter = Gtk.TreeIter();
+            return false;
+        }
+
+        return make_iter(out iter, n);
+    }
+
+    public bool iter_parent(out Gtk.TreeIter iter, Gtk.TreeIter child) {
+        iter = Gtk.TreeIter();
+        return false;
+    }
+}
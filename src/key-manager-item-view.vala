@@ -0,0 +1,134 @@
+/*
+ * Seahorse
+ *
+ * Copyright (C) 2026 Seahorse contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * The list of items in the KeyManager (i.e. the main window).
+ *
+ * Rather than creating widgets for every item, this only draws the rows that
+ * are visible, so it doesn't get slower (or bigger) with the keyring.
+ */
+public class Seahorse.KeyManagerItemView : Gtk.TreeView {
+
+    private KeyManagerItemModel item_model;
+    private uint update_tick_id = 0;
+
+    public KeyManagerItemView(GLib.ListModel items) {
+        GLib.Object(
+            headers_visible: false,
+            enable_search: false
+        );
+
+        this.item_model = new KeyManagerItemModel(items);
+        this.item_model.changes_pending.connect(on_item_changes_pending);
+        get_selection().mode = Gtk.SelectionMode.MULTIPLE;
+
+        // Rows can have a different height (eg. keys with several user IDs),
+        // so these are measured once they're needed, rather than using a
+        // fixed height. The width only depends on the view though.
+        var column = new Gtk.TreeViewColumn();
+        column.sizing = Gtk.TreeViewColumnSizing.FIXED;
+        column.expand = true;
+        column.spacing = 12;
+
+        var icon_renderer = new Gtk.CellRendererPixbuf();
+        icon_renderer.stock_size = (uint) Gtk.IconSize.DND;
+        icon_renderer.yalign = 0.0f;
+        icon_renderer.set_padding(12, 12);
+        column.pack_start(icon_renderer, false);
+        column.set_cell_data_func(icon_renderer, icon_cell_data);
+
+        var markup_renderer = new Gtk.CellRendererText();
+        markup_renderer.ellipsize = Pango.EllipsizeMode.END;
+        markup_renderer.set_padding(0, 12);
+        column.pack_start(markup_renderer, true);
+        column.set_cell_data_func(markup_renderer, markup_cell_data);
+
+        var description_renderer = new Gtk.CellRendererText();
+        description_renderer.xalign = 1.0f;
+        description_renderer.yalign = 0.0f;
+        description_renderer.scale = Pango.Scale.SMALL;
+        description_renderer.set_padding(12, 12);
+        column.pack_end(description_renderer, false);
+        column.set_cell_data_func(description_renderer, description_cell_data);
+
+        append_column(column);
+        this.model = this.item_model;
+    }
+
+    private void on_item_changes_pending() {
+        // Only update the rows right before the next frame, so all changes
+        // until then (eg. all properties of an item, or all items of a
+        // keyring that's refreshed) need only one update for every row
+        if (this.update_tick_id == 0)
+            this.update_tick_id = add_tick_callback(on_update_tick);
+    }
+
+    private bool on_update_tick(Gtk.Widget widget, Gdk.FrameClock frame_clock) {
+        this.update_tick_id = 0;
+        this.item_model.update_changed_rows();
+        return GLib.Source.REMOVE;
+    }
+
+    private void icon_cell_data(Gtk.TreeViewColumn column, Gtk.CellRenderer cell,
+                                Gtk.TreeModel model, Gtk.TreeIter iter) {
+        GLib.Icon? icon = null;
+        this.item_model.get_object(iter).get("icon", out icon);
+        ((Gtk.CellRendererPixbuf) cell).gicon = icon;
+    }
+
+    private void markup_cell_data(Gtk.TreeViewColumn column, Gtk.CellRenderer cell,
+                                  Gtk.TreeModel model, Gtk.TreeIter iter) {
+        string? markup = null;
+        this.item_model.get_object(iter).get("markup", out markup);
+        ((Gtk.CellRendererText) cell).markup = markup;
+    }
+
+    private void description_cell_data(Gtk.TreeViewColumn column, Gtk.CellRenderer cell,
+                                       Gtk.TreeModel model, Gtk.TreeIter iter) {
+        var item = this.item_model.get_object(iter);
+        string? description = null;
+        if (item.get_class().find_property("description") != null)
+            item.get("description", out description);
+        ((Gtk.CellRendererText) cell).text = description;
+    }
+
+    /** Returns the item that is shown at @path (if any) */
+    public GLib.Object? get_object_at_path(Gtk.TreePath path) {
+        Gtk.TreeIter iter;
+        if (!this.item_model.get_iter(out iter, path))
+            return null;
+        return this.item_model.get_object(iter);
+    }
+
+    /** Returns the selected items, in the order they're shown */
+    public GLib.List<GLib.Object> get_selected_objects() {
+        var objects = new GLib.List<GLib.Object>();
+
+        unowned Gtk.TreeModel model;
+        foreach (unowned Gtk.TreePath path in get_selection().get_selected_rows(out model)) {
+            var object = get_object_at_path(path);
+            if (object != null)
+                objects.prepend(object);
+        }
+
+        objects.reverse();
+        return objects;
+    }
+}
@@ -45,7 +45,8 @@ public class Seahorse.KeyManager : Catalog {
     [GtkChild]
     private unowned Gtk.Stack content_stack;
     [GtkChild]
-    private unowned Gtk.ListBox item_listbox;
+    private unowned Gtk.ScrolledWindow item_view_area;
+    private KeyManagerItemView item_view;
 
     [GtkChild]
     private unowned Gtk.MenuButton new_item_button;
@@ -82,14 +83,16 @@ public class Seahorse.KeyManager : Catalog {
 
         load_css();
 
-        // Add new item list and bind our listbox to it
+        // Add new item list and show it in our view
         this.item_list = new Seahorse.ItemList(this.collection);
         this.item_list.items_changed.connect((idx, removed, added) => check_empty_state());
-        this.item_listbox.bind_model(this.item_list, (obj) => { return new KeyManagerItemRow(obj); });
-        this.item_listbox.row_activated.connect(on_item_listbox_row_activated);
-        this.item_listbox.selected_rows_changed.connect(on_item_listbox_selected_rows_changed);
-        this.item_listbox.popup_menu.connect(on_item_listbox_popup_menu);
-        this.item_listbox.button_press_event.connect(on_item_listbox_button_press_event);
+        this.item_view = new KeyManagerItemView(this.item_list);
+        this.item_view.row_activated.connect(on_item_view_row_activated);
+        this.item_view.get_selection().changed.connect(on_item_view_selection_changed);
+        this.item_view.popup_menu.connect(on_item_view_popup_menu);
+        this.item_view.button_press_event.connect(on_item_view_button_press_event);
+        this.item_view.show();
+        this.item_view_area.add(this.item_view);
 
         init_actions();
 
@@ -137,28 +140,31 @@ public class Seahorse.KeyManager : Catalog {
             get_style_context().add_class("devel");
     }
 
-    private void on_item_listbox_row_activated(Gtk.ListBox item_listbox, Gtk.ListBoxRow row) {
-        unowned GLib.Object obj = ((KeyManagerItemRow) row).object;
+    private void on_item_view_row_activated(Gtk.TreeView item_view, Gtk.TreePath path,
+                                            Gtk.TreeViewColumn? column) {
+        var obj = this.item_view.get_object_at_path(path);
         assert(obj != null);
         show_properties(obj);
     }
 
-    private void on_item_listbox_selected_rows_changed(Gtk.ListBox item_listbox) {
+    private void on_item_view_selection_changed(Gtk.TreeSelection selection) {
         selection_changed();
     }
 
-    private bool on_item_listbox_button_press_event (Gdk.EventButton event) {
+    private bool on_item_view_button_press_event (Gdk.EventButton event) {
         // Check for right click
         if ((event.type == Gdk.EventType.BUTTON_PRESS) && (event.button == 3)) {
             // Make sure that the right-clicked row is also selected
-            var row = this.item_listbox.get_row_at_y((int) event.y);
-            if (row != null) {
-                this.item_listbox.unselect_all();
-                this.item_listbox.select_row(row);
+            Gtk.TreePath? path;
+            if (this.item_view.get_path_at_pos((int) event.x, (int) event.y,
+                                               out path, null, null, null)) {
+                var selection = this.item_view.get_selection();
+                selection.unselect_all();
+                selection.select_path(path);
             }
 
             // Show context menu (unless no row was right clicked or nothing was selected)
-            var objects = get_selected_item_listbox_items();
+            var objects = this.item_view.get_selected_objects();
             debug("We have %u selected objects", objects.length());
             if (objects != null)
                 show_context_menu(null);
@@ -168,23 +174,13 @@ public class Seahorse.KeyManager : Catalog {
         return false;
     }
 
-    private bool on_item_listbox_popup_menu(Gtk.Widget? listview) {
-        var objects = get_selected_item_listbox_items();
+    private bool on_item_view_popup_menu(Gtk.Widget? listview) {
+        var objects = this.item_view.get_selected_objects();
         if (objects != null)
             show_context_menu(null);
         return false;
     }
 
-    private GLib.List<weak GLib.Object> get_selected_item_listbox_items() {
-        var rows = this.item_listbox.get_selected_rows();
-        var objects = new GLib.List<weak GLib.Object>();
-
-        foreach (var row in rows)
-            objects.prepend(((KeyManagerItemRow) row).object);
-
-        return objects;
-    }
-
     public override void selection_changed() {
         base.selection_changed();
 
@@ -199,7 +195,7 @@ public class Seahorse.KeyManager : Catalog {
 
         this.show_search_button.sensitive = !empty;
         if (!empty) {
-            this.content_stack.visible_child_name = "item_listbox_page";
+            this.content_stack.visible_child_name = "item_view_page";
             return;
         }
 
@@ -396,12 +392,7 @@ public class Seahorse.KeyManager : Catalog {
     }
 
     public override GLib.List<GLib.Object> get_selected_objects() {
-        var objects = new GLib.List<GLib.Object>();
-
-        foreach (var row in this.item_listbox.get_selected_rows()) {
-            objects.append(((KeyManagerItemRow) row).object);
-        }
-        return objects;
+        return this.item_view.get_selected_objects();
     }
 
     private void on_focus_place(SimpleAction action, Variant? param) {
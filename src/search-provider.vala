@@ -112,9 +112,10 @@ public class Seahorse.SearchProvider : GLib.Object {
         if (get_n_loading() >= 0)
             yield load();
 
+        var keys_with_ids = find_keys_with_ids(terms);
         string?[] results = {};
-        foreach (unowned GLib.Object obj in this.collection.get_objects()) {
-            if (object_matches_search(obj, terms)) {
+        foreach (unowned GLib.Object obj in get_candidates(keys_with_ids)) {
+            if (object_matches_search(obj, terms, keys_with_ids)) {
                 string str = "%p".printf(obj);
 
                 if (!(str in this.handles)) {
@@ -133,13 +134,14 @@ public class Seahorse.SearchProvider : GLib.Object {
             throws GLib.Error {
         this.app.hold ();
 
+        var keys_with_ids = find_keys_with_ids(new_terms);
         string?[] results = {};
         foreach (string previous_result in previous_results) {
             unowned GLib.Object? object = this.handles.lookup(previous_result);
             if (object == null || !this.collection.contains(object))
                 continue; // Bogus value
 
-            if (object_matches_search(object, new_terms))
+            if (object_matches_search(object, new_terms, keys_with_ids))
                 results += previous_result;
         }
 
@@ -203,9 +205,44 @@ public class Seahorse.SearchProvider : GLib.Object {
         // TODO
     }
 
-    private bool object_matches_search (GLib.Object? object, string[] terms) {
-        foreach (unowned string term in ((string[]) terms)) {
-            if (!object_contains_filtered_text (object, term))
+    // If a term is a key ID or fingerprint, only the keys it belongs to
+    // can match, which are looked up rather than searching all of them
+    private GLib.List<weak GLib.Object> get_candidates (GLib.GenericSet<GLib.Object>[] keys_with_ids) {
+        foreach (unowned GLib.GenericSet<GLib.Object> found in keys_with_ids) {
+            if (found.length == 0)
+                continue;
+
+            var candidates = new GLib.List<weak GLib.Object>();
+            foreach (unowned GLib.Object object in found.get_values()) {
+                if (this.collection.contains(object))
+                    candidates.prepend(object);
+            }
+            return candidates;
+        }
+
+        return this.collection.get_objects();
+    }
+
+    // The keys that have each term as a key ID or fingerprint, looked up
+    // once for the whole search rather than for every object
+    private static GLib.GenericSet<GLib.Object>[] find_keys_with_ids (string[] terms) {
+        var keys_with_ids = new GLib.GenericSet<GLib.Object>[terms.length];
+        for (int i = 0; i < terms.length; i++) {
+            keys_with_ids[i] = new GLib.GenericSet<GLib.Object>(GLib.direct_hash, GLib.direct_equal);
+
+            // Anything shorter than a short key ID isn't worth a lookup
+            if (terms[i].length < 8)
+                continue;
+            foreach (unowned GLib.Object object in KeyIndex.get_default().find(terms[i]).data)
+                keys_with_ids[i].add(object);
+        }
+        return keys_with_ids;
+    }
+
+    private bool object_matches_search (GLib.Object? object, string[] terms,
+                                        GLib.GenericSet<GLib.Object>[] keys_with_ids) {
+        for (int i = 0; i < terms.length; i++) {
+            if (!object_contains_filtered_text (object, terms[i]) && !keys_with_ids[i].contains (object))
                 return false;
         }
 
@@ -22,7 +22,7 @@
 /**
  * Represents an SSH key, consisting of a public/private pair.
  */
-public class Seahorse.Ssh.Key : Seahorse.Object, Seahorse.Exportable, Seahorse.Deletable, Seahorse.Viewable {
+public class Seahorse.Ssh.Key : Seahorse.Object, Seahorse.Exportable, Seahorse.Deletable, Seahorse.Viewable, Seahorse.Searchable {
     public const int SSH_IDENTIFIER_SIZE = 8;
 
     private KeyData? _keydata;
@@ -170,6 +170,22 @@ public class Seahorse.Ssh.Key : Seahorse.Object, Seahorse.Exportable, Seahorse.D
         return properties_dialog;
     }
 
+    public string get_search_text() {
+        return (this.fingerprint != null)? this.fingerprint + "\n" : "";
+    }
+
+    [CCode (array_length = false, array_null_terminated = true)]
+    public string[]? get_search_field(string field) {
+        switch (field) {
+            case "fpr":
+                return (this.fingerprint != null)? new string[] { this.fingerprint } : new string[0];
+            case "type":
+                return { "ssh" };
+            default:
+                return null;
+        }
+    }
+
     public Algorithm get_algo() {
         return this.key_data.algo;
     }
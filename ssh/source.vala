@@ -41,6 +41,9 @@ public class Seahorse.Ssh.Source : GLib.Object, Gcr.Collection, Seahorse.Place {
 
     // The list of Seahorse.Ssh.Keys
     private ListStore keys = new ListStore(typeof(Ssh.Key));
+    // The same keys, by fingerprint and (if they have one) private key file
+    private HashTable<string, Key> keys_by_fingerprint = new HashTable<string, Key>(str_hash, str_equal);
+    private HashTable<string, Key> keys_by_privfile = new HashTable<string, Key>(str_hash, str_equal);
 
     public string label {
         owned get { return _("OpenSSH keys"); }
@@ -185,12 +188,18 @@ public class Seahorse.Ssh.Source : GLib.Object, Gcr.Collection, Seahorse.Place {
     }
 
     public bool contains(GLib.Object object) {
-        return this.keys.find(object, null);
+        unowned var key = object as Key;
+        return key != null && key.fingerprint != null
+            && this.keys_by_fingerprint.lookup(key.fingerprint) == key;
     }
 
     public void remove_object(GLib.Object object) {
         uint pos;
         if (this.keys.find(object, out pos)) {
+            var key = (Key) object;
+            this.keys_by_fingerprint.remove(key.fingerprint);
+            if (key.key_data.privfile != null)
+                this.keys_by_privfile.remove(key.key_data.privfile);
             this.keys.remove(pos);
             removed(object);
         }
@@ -209,12 +218,9 @@ public class Seahorse.Ssh.Source : GLib.Object, Gcr.Collection, Seahorse.Place {
             return null;
 
         // Check if it was already loaded once. If not, load it now
-        for (uint i = 0; i < this.keys.get_n_items(); i++) {
-            var key = (Ssh.Key) this.keys.get_item(i);
-            if (key.key_data.privfile == privfile) {
-                return key;
-            }
-        }
+        Key? key = this.keys_by_privfile.lookup(privfile);
+        if (key != null)
+            return key;
 
         return yield load_key_for_private_file(privfile);
     }
@@ -325,6 +331,9 @@ public class Seahorse.Ssh.Source : GLib.Object, Gcr.Collection, Seahorse.Place {
         // Create a new key
         Key key = new Key(src, keydata);
         src.keys.append(key);
+        src.keys_by_fingerprint.insert(keydata.fingerprint, key);
+        if (keydata.privfile != null)
+            src.keys_by_privfile.insert(keydata.privfile, key);
         src.added(key);
 
         return key;
@@ -452,13 +461,6 @@ public class Seahorse.Ssh.Source : GLib.Object, Gcr.Collection, Seahorse.Place {
     }
 
     public Key? find_key_by_fingerprint(string fingerprint) {
-        for (uint i = 0; i < this.keys.get_n_items(); i++) {
-            var key = (Ssh.Key) this.keys.get_item(i);
-            if (key.fingerprint == fingerprint) {
-                return key;
-            }
-        }
-
-        return null;
+        return this.keys_by_fingerprint.lookup(fingerprint);
     }
 }